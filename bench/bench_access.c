@@ -0,0 +1,127 @@
+/*
+ * scv - Simple C Vector
+ *
+ * bench_access.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Compare sequential iteration using the library scv_at, the inline
+ * scv_at from SCV_INLINE_ACCESSORS, and a raw pointer.
+ *
+ * Usage: bench_access [elements] [rounds]
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#  define _POSIX_C_SOURCE 199309L
+#endif
+
+#define SCV_INLINE_ACCESSORS
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#include "scv.h"
+
+static void report(const char *name, double t, size_t n, long sum)
+{
+	printf("%-16s %8.2f ms  %6.3f ns/element  (sum %ld)\n",
+	       name, t * 1e3, t * 1e9 / (double) n, sum);
+}
+
+int main(int argc, char *argv[])
+{
+	struct scv_vector *v;
+	size_t n = 10000000;
+	size_t rounds = 10;
+	size_t i;
+	size_t r;
+	double t;
+	long sum;
+	int j;
+
+	if (argc > 1) {
+		n = (size_t) strtoul(argv[1], NULL, 10);
+	}
+
+	if (argc > 2) {
+		rounds = (size_t) strtoul(argv[2], NULL, 10);
+	}
+
+	v = scv_new(sizeof(int), n);
+
+	for (i = 0; i < n; ++i) {
+		j = (int) (i & 0xFF);
+		scv_push_back(v, &j);
+	}
+
+	printf("iterate %lu ints %lu times\n", (unsigned long) n, (unsigned long) rounds);
+
+	sum = 0;
+	t = bench_now();
+	for (r = 0; r < rounds; ++r) {
+		for (i = 0; i < scv_size(v); ++i) {
+			sum += *(int *) (scv_at)(v, i);
+		}
+	}
+	report("library scv_at", bench_now() - t, n * rounds, sum);
+
+	sum = 0;
+	t = bench_now();
+	for (r = 0; r < rounds; ++r) {
+		for (i = 0; i < scv_size(v); ++i) {
+			sum += *(int *) scv_at(v, i);
+		}
+	}
+	report("inline scv_at", bench_now() - t, n * rounds, sum);
+
+	sum = 0;
+	t = bench_now();
+	for (r = 0; r < rounds; ++r) {
+		const int *p = scv_data(v);
+
+		for (i = 0; i < scv_size(v); ++i) {
+			sum += p[i];
+		}
+	}
+	report("raw pointer", bench_now() - t, n * rounds, sum);
+
+	scv_clear(v);
+
+	t = bench_now();
+	for (i = 0; i < n; ++i) {
+		j = (int) i;
+		(scv_push_back)(v, &j);
+	}
+	report("library push", bench_now() - t, n, (long) scv_size(v));
+
+	scv_clear(v);
+
+	t = bench_now();
+	for (i = 0; i < n; ++i) {
+		j = (int) i;
+		scv_push_back(v, &j);
+	}
+	report("inline push", bench_now() - t, n, (long) scv_size(v));
+
+	scv_delete(v);
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * scv - Simple C Vector
+ *
+ * bench_growth.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Compare growth policies on a push_back heavy workload, where a single
+ * vector grows large, and a memory bound workload, where many vectors
+ * grow to random small sizes.
+ *
+ * Usage: bench_growth [elements]
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#  define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#include "scv.h"
+
+#define NUM_SMALL 10000
+
+static const struct scv_growth exact = { 0, 100, 100, 0, NULL, NULL };
+static const struct scv_growth quad = { 64, 400, 400, 0, NULL, NULL };
+
+static void push_back_heavy(const char *name, const struct scv_growth *growth, size_t n)
+{
+	struct scv_vector *v;
+	double t;
+	size_t ngrow = 0;
+	size_t i;
+
+	v = scv_new(sizeof(size_t), 1);
+	scv_set_growth(v, growth);
+
+	t = bench_now();
+
+	for (i = 0; i < n; ++i) {
+		if (scv_size(v) == scv_capacity(v)) {
+			ngrow += 1;
+		}
+
+		scv_push_back(v, &i);
+	}
+
+	t = bench_now() - t;
+
+	printf("  %-8s %9lu elements %9.2f ms, %7lu grows, capacity %.2fx size\n",
+	       name, (unsigned long) n, t * 1e3, (unsigned long) ngrow,
+	       (double) scv_capacity(v) / (double) scv_size(v));
+
+	scv_delete(v);
+}
+
+static void memory_bound(const char *name, const struct scv_growth *growth, size_t n)
+{
+	static struct scv_vector *v[NUM_SMALL];
+	double t;
+	size_t used = 0;
+	size_t allocated = 0;
+	size_t i;
+	size_t j;
+
+	srand(1);
+
+	t = bench_now();
+
+	for (i = 0; i < NUM_SMALL; ++i) {
+		size_t len = (size_t) rand() % (2 * (n / NUM_SMALL) + 1);
+
+		v[i] = scv_new(sizeof(size_t), 1);
+		scv_set_growth(v[i], growth);
+
+		for (j = 0; j < len; ++j) {
+			scv_push_back(v[i], &j);
+		}
+	}
+
+	t = bench_now() - t;
+
+	for (i = 0; i < NUM_SMALL; ++i) {
+		used += scv_size(v[i]) * sizeof(size_t);
+		allocated += scv_capacity(v[i]) * sizeof(size_t);
+		scv_delete(v[i]);
+	}
+
+	printf("  %-8s %9.2f ms, %7lu KiB used, %7lu KiB allocated\n",
+	       name, t * 1e3, (unsigned long) (used >> 10),
+	       (unsigned long) (allocated >> 10));
+}
+
+int main(int argc, char *argv[])
+{
+	size_t n = 10000000;
+
+	if (argc > 1) {
+		n = (size_t) strtoul(argv[1], NULL, 10);
+	}
+
+	/* Exact fit is quadratic, so use fewer elements */
+	printf("push_back into one vector\n");
+
+	push_back_heavy("default", NULL, n);
+	push_back_heavy("exact", &exact, n / 100);
+	push_back_heavy("factor4", &quad, n);
+
+	printf("push_back %lu elements into %d vectors\n", (unsigned long) n, NUM_SMALL);
+
+	memory_bound("default", NULL, n);
+	memory_bound("exact", &exact, n);
+	memory_bound("factor4", &quad, n);
+
+	return 0;
+}
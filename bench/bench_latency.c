@@ -0,0 +1,112 @@
+/*
+ * scv - Simple C Vector
+ *
+ * bench_latency.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the latency distribution of scv_push_back with and without
+ * incremental growth.
+ *
+ * Usage: bench_latency [elements] [step]
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#  define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#include "scv.h"
+
+static int float_compare(const void *lhs, const void *rhs)
+{
+	float a = *(const float *) lhs;
+	float b = *(const float *) rhs;
+
+	return (a > b) - (a < b);
+}
+
+static void run(const char *name, size_t step, float *lat, size_t n)
+{
+	struct scv_vector *v;
+	double total;
+	size_t i;
+
+	v = scv_new(sizeof(size_t), 1);
+	scv_set_incremental(v, step);
+
+	total = bench_now();
+
+	for (i = 0; i < n; ++i) {
+		double t = bench_now();
+
+		scv_push_back(v, &i);
+
+		lat[i] = (float) ((bench_now() - t) * 1e6);
+	}
+
+	total = bench_now() - total;
+
+	scv_delete(v);
+
+	qsort(lat, n, sizeof *lat, float_compare);
+
+	printf("%-12s total %8.1f ms  p50 %6.3f us  p99 %6.3f us  p999 %8.3f us  max %10.3f us\n",
+	       name, total * 1e3, lat[n / 2], lat[n - n / 100],
+	       lat[n - n / 1000], lat[n - 1]);
+}
+
+int main(int argc, char *argv[])
+{
+	float *lat;
+	size_t n = 10000000;
+	size_t step = 16;
+
+	if (argc > 1) {
+		n = (size_t) strtoul(argv[1], NULL, 10);
+	}
+
+	if (argc > 2) {
+		step = (size_t) strtoul(argv[2], NULL, 10);
+	}
+
+	if (n < 1000) {
+		n = 1000;
+	}
+
+	lat = (float *) malloc(n * sizeof *lat);
+
+	if (lat == NULL) {
+		fprintf(stderr, "allocation failed\n");
+		return 1;
+	}
+
+	printf("push_back %lu elements\n", (unsigned long) n);
+
+	run("default", 0, lat, n);
+	run("incremental", step, lat, n);
+
+	free(lat);
+
+	return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * scv - Simple C Vector
+ *
+ * bench_mremap.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure growth latency of a large vector with the default allocator and
+ * with scv_mmap_allocator.
+ *
+ * Usage: bench_mremap [megabytes]
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#  define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#include "scv.h"
+
+static void run(const char *name, const struct scv_allocator *allocator, size_t nbytes)
+{
+	struct scv_vector *v;
+	double start;
+	double total;
+	double worst = 0.0;
+	size_t ngrow = 0;
+	size_t i;
+	size_t n = nbytes / sizeof(size_t);
+
+	v = scv_new_with_allocator(sizeof(size_t), 0, allocator);
+
+	if (v == NULL) {
+		fprintf(stderr, "%s: allocation failed\n", name);
+		return;
+	}
+
+	total = bench_now();
+
+	for (i = 0; i < n; ++i) {
+		if (scv_size(v) == scv_capacity(v)) {
+			double t;
+
+			start = bench_now();
+
+			if (scv_push_back(v, &i) != SCV_OK) {
+				fprintf(stderr, "%s: push_back failed\n", name);
+				break;
+			}
+
+			t = bench_now() - start;
+
+			if (t > worst) {
+				worst = t;
+			}
+
+			ngrow += 1;
+		}
+		else {
+			scv_push_back(v, &i);
+		}
+	}
+
+	total = bench_now() - total;
+
+	printf("%-8s %8.1f ms total, %4lu grows, worst grow %8.3f ms\n",
+	       name, total * 1e3, (unsigned long) ngrow, worst * 1e3);
+
+	scv_delete(v);
+}
+
+int main(int argc, char *argv[])
+{
+	struct scv_mmap_allocator ma;
+	size_t mb = 512;
+
+	if (argc > 1) {
+		mb = (size_t) strtoul(argv[1], NULL, 10);
+	}
+
+	scv_mmap_allocator_init(&ma, 0);
+
+	printf("growing vector to %lu MiB\n", (unsigned long) mb);
+
+	run("malloc", NULL, mb << 20);
+	run("mmap", &ma.allocator, mb << 20);
+
+	return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * scv - Simple C Vector
+ *
+ * bench_parallel.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Time scv_sort_parallel on random ints with 1, 2, 4, ... threads up to
+ * the number given, and report the speedup over scv_sort.
+ *
+ * Usage: bench_parallel [elements] [threads]
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#  define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#include "scv.h"
+#include "scv_sort.h"
+
+static unsigned long bench_state = 1;
+
+static int bench_rand(void)
+{
+	bench_state = bench_state * 1103515245ul + 12345ul;
+
+	return (int) ((bench_state >> 8) & 0xFFFFFFul);
+}
+
+static int int_compare(const void *lhs, const void *rhs)
+{
+	int a = *(const int *) lhs;
+	int b = *(const int *) rhs;
+
+	return (a > b) - (a < b);
+}
+
+int main(int argc, char *argv[])
+{
+	struct scv_vector *src;
+	struct scv_vector *v;
+	size_t n = 10000000;
+	size_t max_threads = 8;
+	size_t nthreads;
+	size_t i;
+	double serial;
+	double t;
+
+	if (argc > 1) {
+		n = (size_t) strtoul(argv[1], NULL, 10);
+	}
+
+	if (argc > 2) {
+		max_threads = (size_t) strtoul(argv[2], NULL, 10);
+	}
+
+	src = scv_new(sizeof(int), n);
+	v = scv_new(sizeof(int), n);
+
+	for (i = 0; i < n; ++i) {
+		int j = bench_rand();
+
+		scv_push_back(src, &j);
+	}
+
+	printf("sort %lu elements\n", (unsigned long) n);
+
+	scv_copy(v, src);
+	t = bench_now();
+	scv_sort(v, int_compare);
+	serial = bench_now() - t;
+
+	printf("%-12s %8.2f ms\n", "scv_sort", serial * 1e3);
+
+	for (nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+		scv_copy(v, src);
+		t = bench_now();
+		scv_sort_parallel(v, int_compare, nthreads);
+		t = bench_now() - t;
+
+		printf("%2lu threads   %8.2f ms  %5.2fx\n", (unsigned long) nthreads,
+		       t * 1e3, serial / t);
+	}
+
+	scv_delete(v);
+	scv_delete(src);
+
+	return 0;
+}
@@ -0,0 +1,173 @@
+/*
+ * scv - Simple C Vector
+ *
+ * bench_rope.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+/*
+ * Compare inserting single elements at random and at clustered positions
+ * in a scv_vector, a scv_gap, and a scv_rope, and iterating over the
+ * result.
+ *
+ * Usage: bench_rope [elements] [inserts]
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#  define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#include "scv.h"
+#include "scv_gap.h"
+#include "scv_rope.h"
+
+static unsigned long bench_state = 1;
+
+static size_t bench_rand(void)
+{
+	bench_state = bench_state * 1103515245ul + 12345ul;
+
+	return (size_t) ((bench_state >> 8) & 0xFFFFFFul);
+}
+
+/**
+ * Return the next insert position, either uniform over `[0, size]`, or
+ * drifting by a small amount from the previous one.
+ */
+static size_t next_pos(size_t prev, size_t size, int clustered)
+{
+	if (!clustered) {
+		return bench_rand() % (size + 1);
+	}
+
+	prev = prev + bench_rand() % 33;
+	prev = prev > 16 ? prev - 16 : 0;
+
+	return prev > size ? size : prev;
+}
+
+static void report(const char *name, double t, size_t n)
+{
+	printf("%-16s %10.2f ms  %9.1f ns/op\n", name, t * 1e3, t * 1e9 / (double) n);
+}
+
+static void run(size_t n, size_t inserts, int clustered)
+{
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	struct scv_gap *g = scv_gap_new(sizeof(int), 0);
+	struct scv_rope *r = scv_rope_new(sizeof(int));
+	struct scv_rope_cursor c;
+	size_t pos;
+	size_t i;
+	size_t m;
+	double t;
+	long sum;
+	int j;
+	int *p;
+
+	for (i = 0; i < n; ++i) {
+		j = (int) i;
+		scv_push_back(v, &j);
+	}
+
+	scv_gap_insert(g, 0, scv_data(v), n);
+	scv_rope_insert(r, 0, scv_data(v), n);
+
+	printf("%s inserts, %lu ints + %lu inserts\n", clustered ? "clustered" : "random",
+	       (unsigned long) n, (unsigned long) inserts);
+
+	bench_state = 1;
+	pos = n / 2;
+	t = bench_now();
+	for (i = 0; i < inserts; ++i) {
+		pos = next_pos(pos, scv_size(v), clustered);
+		j = (int) i;
+		scv_insert(v, pos, &j, 1);
+	}
+	report("scv_insert", bench_now() - t, inserts);
+
+	bench_state = 1;
+	pos = n / 2;
+	t = bench_now();
+	for (i = 0; i < inserts; ++i) {
+		pos = next_pos(pos, scv_gap_size(g), clustered);
+		j = (int) i;
+		scv_gap_insert(g, pos, &j, 1);
+	}
+	report("scv_gap_insert", bench_now() - t, inserts);
+
+	bench_state = 1;
+	pos = n / 2;
+	t = bench_now();
+	for (i = 0; i < inserts; ++i) {
+		pos = next_pos(pos, scv_rope_size(r), clustered);
+		j = (int) i;
+		scv_rope_insert(r, pos, &j, 1);
+	}
+	report("scv_rope_insert", bench_now() - t, inserts);
+
+	sum = 0;
+	t = bench_now();
+	p = scv_data(v);
+	for (i = 0; i < scv_size(v); ++i) {
+		sum += p[i];
+	}
+	report("vector iterate", bench_now() - t, scv_size(v));
+
+	t = bench_now();
+	scv_rope_seek(r, &c, 0);
+	while ((p = scv_rope_next(r, &c, &m)) != NULL) {
+		for (i = 0; i < m; ++i) {
+			sum -= p[i];
+		}
+	}
+	report("rope iterate", bench_now() - t, scv_rope_size(r));
+
+	if (sum != 0) {
+		printf("mismatch between vector and rope\n");
+	}
+
+	scv_rope_delete(r);
+	scv_gap_delete(g);
+	scv_delete(v);
+}
+
+int main(int argc, char *argv[])
+{
+	size_t n = 1000000;
+	size_t inserts = 20000;
+
+	if (argc > 1) {
+		n = (size_t) strtoul(argv[1], NULL, 10);
+	}
+
+	if (argc > 2) {
+		inserts = (size_t) strtoul(argv[2], NULL, 10);
+	}
+
+	run(n, inserts, 0);
+	run(n, inserts, 1);
+
+	return 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * scv - Simple C Vector
+ *
+ * bench_sort.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Compare qsort, scv_sort, scv_stable_sort, and scv_radix_sort on random
+ * ints and on the point structure from the README.
+ *
+ * Usage: bench_sort [elements]
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#  define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#include "scv.h"
+#include "scv_sort.h"
+
+struct point {
+	int x;
+	int y;
+};
+
+static unsigned long bench_state = 1;
+
+static int bench_rand(void)
+{
+	bench_state = bench_state * 1103515245ul + 12345ul;
+
+	return (int) ((bench_state >> 8) & 0xFFFFFFul);
+}
+
+static int int_compare(const void *lhs, const void *rhs)
+{
+	int a = *(const int *) lhs;
+	int b = *(const int *) rhs;
+
+	return (a > b) - (a < b);
+}
+
+static int point_compare(const void *lhs, const void *rhs)
+{
+	const struct point *a = (const struct point *) lhs;
+	const struct point *b = (const struct point *) rhs;
+
+	if (a->x == b->x) {
+		return (a->y > b->y) - (a->y < b->y);
+	}
+
+	return (a->x > b->x) - (a->x < b->x);
+}
+
+static void report(const char *name, double t, size_t n)
+{
+	printf("%-28s %8.2f ms  %6.1f ns/element\n", name, t * 1e3, t * 1e9 / (double) n);
+}
+
+/**
+ * Time qsort, scv_sort, and scv_stable_sort on copies of `src`.
+ */
+static void run(const char *name, struct scv_vector *src,
+                int (*cmp)(const void *, const void *))
+{
+	struct scv_vector *v = scv_new(scv_objsize(src), 0);
+	struct scv_vector *w = scv_new(scv_objsize(src), 0);
+	char label[64];
+	char tmp[64];
+	double t;
+	size_t i;
+
+	scv_copy(v, src);
+	t = bench_now();
+	qsort(scv_data(v), scv_size(v), scv_objsize(v), cmp);
+	sprintf(label, "qsort %s", name);
+	report(label, bench_now() - t, scv_size(v));
+
+	scv_copy(v, src);
+	t = bench_now();
+	scv_sort(v, cmp);
+	sprintf(label, "scv_sort %s", name);
+	report(label, bench_now() - t, scv_size(v));
+
+	/* Sorting sorted input again shows the adaptive case */
+	t = bench_now();
+	scv_sort(v, cmp);
+	sprintf(label, "scv_sort %s sorted", name);
+	report(label, bench_now() - t, scv_size(v));
+
+	scv_copy(v, src);
+	t = bench_now();
+	scv_stable_sort(v, cmp);
+	sprintf(label, "scv_stable_sort %s", name);
+	report(label, bench_now() - t, scv_size(v));
+
+	/* Swap a few elements to get nearly sorted input */
+	for (i = 0; i < scv_size(v) / 100; ++i) {
+		size_t j = (size_t) bench_rand() % scv_size(v);
+
+		memcpy(tmp, scv_at(v, i * 100), scv_objsize(v));
+		memcpy(scv_at(v, i * 100), scv_at(v, j), scv_objsize(v));
+		memcpy(scv_at(v, j), tmp, scv_objsize(v));
+	}
+
+	scv_copy(w, v);
+	t = bench_now();
+	scv_sort(w, cmp);
+	sprintf(label, "scv_sort %s nearly", name);
+	report(label, bench_now() - t, scv_size(v));
+
+	t = bench_now();
+	scv_stable_sort(v, cmp);
+	sprintf(label, "scv_stable_sort %s nearly", name);
+	report(label, bench_now() - t, scv_size(v));
+
+	scv_delete(w);
+	scv_delete(v);
+}
+
+/**
+ * Time scv_radix_sort on a copy of `src`, with keys of `nkeys` ints from
+ * least to most significant.
+ */
+static void run_radix(const char *name, struct scv_vector *src, const size_t *keys,
+                      size_t nkeys)
+{
+	struct scv_vector *v = scv_new(scv_objsize(src), 0);
+	struct scv_vector *scratch = scv_new(scv_objsize(src), scv_size(src));
+	char label[64];
+	double t;
+	size_t k;
+
+	scv_copy(v, src);
+	t = bench_now();
+	for (k = 0; k < nkeys; ++k) {
+		scv_radix_sort_scratch(v, keys[k], sizeof(int), SCV_RADIX_SIGNED, scratch);
+	}
+	sprintf(label, "scv_radix_sort %s", name);
+	report(label, bench_now() - t, scv_size(v));
+
+	scv_delete(scratch);
+	scv_delete(v);
+}
+
+int main(int argc, char *argv[])
+{
+	static const size_t int_key[] = { 0 };
+	static const size_t point_keys[] = { offsetof(struct point, y), offsetof(struct point, x) };
+	struct scv_vector *ints;
+	struct scv_vector *points;
+	size_t n = 1000000;
+	size_t i;
+
+	if (argc > 1) {
+		n = (size_t) strtoul(argv[1], NULL, 10);
+	}
+
+	ints = scv_new(sizeof(int), n);
+	points = scv_new(sizeof(struct point), n);
+
+	for (i = 0; i < n; ++i) {
+		struct point p;
+		int j = bench_rand();
+
+		p.x = bench_rand() % 1000;
+		p.y = bench_rand() % 1000;
+
+		scv_push_back(ints, &j);
+		scv_push_back(points, &p);
+	}
+
+	printf("sort %lu elements\n", (unsigned long) n);
+
+	run("int", ints, int_compare);
+	run_radix("int", ints, int_key, 1);
+	run("point", points, point_compare);
+	run_radix("point", points, point_keys, 2);
+
+	scv_delete(points);
+	scv_delete(ints);
+
+	return 0;
+}
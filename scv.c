@@ -20,10 +20,27 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE
+#endif
+
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
+#if defined(__linux__)
+#  include <sys/mman.h>
+#  include <unistd.h>
+#  if defined(MREMAP_MAYMOVE)
+#    define SCV_HAVE_MREMAP 1
+#  endif
+#  define SCV_HAVE_POSIX_MEMALIGN 1
+#endif
+
+/* The library always provides the out-of-line functions */
+#undef SCV_INLINE_ACCESSORS
+
 #include "scv.h"
 
 /**
@@ -41,356 +58,2027 @@
 #define SCV_MIN_ALLOC (64u)
 
 /**
- * Grow the capacity of `v` to at least `capacity`.
+ * Allocate `size` bytes using `allocator`.
  *
- * If more space is needed, grow `v` to `capacity`, but at least by a factor
- * of 1.5.
- *
- * @param v pointer to `scv_vector`
- * @param capacity requested capacity
- * @return zero on success, error code on error
+ * @param allocator pointer to allocator, `NULL` for `malloc()`
+ * @param size number of bytes to allocate
+ * @return pointer to allocated memory, `NULL` on error
  */
-static int scv_i_grow(struct scv_vector *v, size_t capacity)
+static void *scv_i_alloc(const struct scv_allocator *allocator, size_t size)
 {
-	void *newdata;
-	size_t newcapacity;
+	if (allocator == NULL) {
+		return malloc(size);
+	}
 
-	assert(v != NULL);
-	assert(v->data != NULL);
+	return allocator->allocate(allocator->ctx, size);
+}
 
-	if (capacity <= v->capacity) {
-		return SCV_OK;
+/**
+ * Resize block at `ptr` from `oldsize` to `newsize` bytes using `allocator`.
+ *
+ * @param allocator pointer to allocator, `NULL` for `realloc()`
+ * @param ptr pointer to block
+ * @param oldsize current size of block in bytes
+ * @param newsize requested size of block in bytes
+ * @return pointer to resized block, `NULL` on error
+ */
+static void *scv_i_realloc(const struct scv_allocator *allocator, void *ptr,
+                           size_t oldsize, size_t newsize)
+{
+	if (allocator == NULL) {
+		return realloc(ptr, newsize);
 	}
 
-	assert(v->objsize > 0);
+	return allocator->reallocate(allocator->ctx, ptr, oldsize, newsize);
+}
 
-	if (capacity >= (size_t) -1 / v->objsize) {
-		return SCV_ERANGE;
+/**
+ * Free block at `ptr` of `size` bytes using `allocator`.
+ *
+ * @param allocator pointer to allocator, `NULL` for `free()`
+ * @param ptr pointer to block
+ * @param size size of block in bytes
+ */
+static void scv_i_free(const struct scv_allocator *allocator, void *ptr, size_t size)
+{
+	if (allocator == NULL) {
+		free(ptr);
+		return;
 	}
 
-	/* Growth factor 2 for small vectors, 1.5 for larger */
-	if (v->capacity < 4096 / v->objsize) {
-		newcapacity = v->capacity + v->capacity + 1;
+	allocator->deallocate(allocator->ctx, ptr, size);
+}
+
+/**
+ * Union of types with strict alignment requirements.
+ */
+union scv_i_max_align {
+	long double ld;
+	double d;
+	long l;
+	void *p;
+	void (*fp)(void);
+};
+
+struct scv_i_align_check {
+	char c;
+	union scv_i_max_align u;
+};
+
+/**
+ * Alignment suitable for any object type.
+ */
+#define SCV_MAX_ALIGN (offsetof(struct scv_i_align_check, u))
+
+/**
+ * Round `n` up to a multiple of `align`, which must be a power of two.
+ */
+#define SCV_ALIGN_UP(n, align) (((n) + ((align) - 1)) & ~((size_t) (align) - 1))
+
+/**
+ * Flag indicating that the memory pointed to by `data` is not owned by
+ * the `scv_vector`, and must not be reallocated or freed.
+ */
+#define SCV_I_BORROWED (1u << 0)
+
+/**
+ * Flag indicating that the `scv_vector` structure was allocated by
+ * `scv_new_small()`, and must be freed with `scv_i_small_free()`.
+ */
+#define SCV_I_SMALL (1u << 2)
+
+/**
+ * State of a `scv_vector` that few vectors use, allocated when first
+ * needed to keep `struct scv_vector` small.
+ */
+struct scv_i_ext {
+	const struct scv_allocator *allocator; /**< Allocator, `NULL` for `malloc()`. */
+	size_t front;     /**< Unused elements before `data`, for `scv_push_front()`. */
+	size_t alignment; /**< Alignment of elements in bytes, zero for default. */
+	size_t offset;    /**< Offset of aligned memory from start of allocated block. */
+	const struct scv_growth *growth; /**< Growth policy, `NULL` for default. */
+	struct scv_i_move *move; /**< State of incremental growth, or `NULL`. */
+	size_t step;      /**< Elements to move per operation, zero if disabled. */
+};
+
+/**
+ * Return allocator of `v`, `NULL` for `malloc()`.
+ */
+#define SCV_ALLOCATOR(v) ((v)->ext != NULL ? (v)->ext->allocator : NULL)
+
+/**
+ * Return number of unused elements before `data` of `v`.
+ */
+#define SCV_FRONT(v) ((v)->ext != NULL ? (v)->ext->front : 0)
+
+/**
+ * Return alignment of elements of `v` in bytes, zero for default.
+ */
+#define SCV_ALIGNMENT(v) ((v)->ext != NULL ? (v)->ext->alignment : 0)
+
+/**
+ * Return offset of `data` from the start of the block used by `v`.
+ */
+#define SCV_OFFSET(v) \
+	((v)->ext != NULL ? (v)->ext->offset + (v)->ext->front * (v)->objsize : 0)
+
+/**
+ * Return state of incremental move of `v`, or `NULL`.
+ */
+#define SCV_MOVE(v) (((v)->flags & SCV_I_MOVING) ? (v)->ext->move : NULL)
+
+/**
+ * Return number of elements of `v` to move per operation.
+ */
+#define SCV_STEP(v) ((v)->ext != NULL ? (v)->ext->step : 0)
+
+#if defined(SCV_STATS)
+
+/**
+ * Statistics for all `scv_vector` objects.
+ */
+static struct scv_stats scv_i_global_stats;
+
+/**
+ * Add `n` to counter `field` of `v` and the global statistics.
+ */
+#  define SCV_COUNT(v, field, n) \
+	((v)->stats.field += (n), scv_i_global_stats.field += (n))
+
+/**
+ * Update peak capacity of `v` and the global statistics.
+ */
+#  define SCV_PEAK(v) scv_i_peak(v)
+
+static void scv_i_peak(struct scv_vector *v)
+{
+	size_t bytes = (SCV_FRONT(v) + v->capacity) * v->objsize;
+
+	if (bytes > v->stats.peak_capacity) {
+		v->stats.peak_capacity = bytes;
 	}
-	else {
-		newcapacity = v->capacity + v->capacity / 2 + 1;
+
+	if (bytes > scv_i_global_stats.peak_capacity) {
+		scv_i_global_stats.peak_capacity = bytes;
 	}
+}
 
-	if (capacity > newcapacity || newcapacity >= (size_t) -1 / v->objsize) {
-		newcapacity = capacity;
+#else /* SCV_STATS */
+
+#  define SCV_COUNT(v, field, n) ((void) 0)
+#  define SCV_PEAK(v) ((void) 0)
+
+#endif /* SCV_STATS */
+
+/**
+ * Return the `scv_i_ext` of `v`, allocating it if needed.
+ *
+ * @param v pointer to `scv_vector`
+ * @return pointer to `scv_i_ext`, `NULL` on error
+ */
+static struct scv_i_ext *scv_i_get_ext(struct scv_vector *v)
+{
+	struct scv_i_ext *ext = v->ext;
+
+	if (ext != NULL) {
+		return ext;
 	}
 
-	newdata = realloc(v->data, newcapacity * v->objsize);
+	ext = (struct scv_i_ext *) scv_i_alloc(NULL, sizeof *ext);
 
-	if (newdata == NULL) {
-		return SCV_ENOMEM;
+	if (ext == NULL) {
+		return NULL;
 	}
 
-	v->data = newdata;
-	v->capacity = newcapacity;
+	/* Vectors without ext use malloc(), have no unused space before the
+	 * elements, and are not aligned, so the block starts at `data` */
+	ext->allocator = NULL;
+	ext->front = 0;
+	ext->alignment = 0;
+	ext->offset = 0;
+	ext->growth = NULL;
+	ext->move = NULL;
+	ext->step = 0;
 
-	return SCV_OK;
+	v->ext = ext;
+
+	return ext;
 }
 
-struct scv_vector *scv_new(size_t objsize, size_t capacity)
+/**
+ * Size of `scv_vector` structure rounded up so inline storage following
+ * it is suitably aligned.
+ */
+#define SCV_SMALL_HDR SCV_ALIGN_UP(sizeof(struct scv_vector), SCV_MAX_ALIGN)
+
+/**
+ * Alignment of blocks allocated by `scv_new_small()`, the size of a
+ * cache line on common processors.
+ */
+#define SCV_CACHE_LINE (64u)
+
+/**
+ * Allocate `size` bytes aligned to `SCV_CACHE_LINE`.
+ *
+ * Without `posix_memalign()`, an extra `SCV_CACHE_LINE` bytes are
+ * allocated, and the offset of the aligned pointer is stored in the byte
+ * before it.
+ *
+ * @param size number of bytes to allocate
+ * @return pointer to allocated memory, `NULL` on error
+ */
+static void *scv_i_small_alloc(size_t size)
 {
-	struct scv_vector *v;
+#if defined(SCV_HAVE_POSIX_MEMALIGN)
+	void *p;
 
-	if (capacity == 0) {
-		capacity = 1;
+	if (posix_memalign(&p, SCV_CACHE_LINE, size) != 0) {
+		return NULL;
 	}
 
-	if (objsize == 0 || capacity >= (size_t) -1 / objsize) {
+	return p;
+#else
+	char *block;
+	size_t offset;
+
+	if (size > (size_t) -1 - SCV_CACHE_LINE) {
 		return NULL;
 	}
 
-	v = (struct scv_vector *) malloc(sizeof *v);
+	block = (char *) malloc(size + SCV_CACHE_LINE);
 
-	if (v == NULL) {
+	if (block == NULL) {
 		return NULL;
 	}
 
-	/* Minimum capacity is SCV_MIN_ALLOC bytes or 1 element */
-	if (capacity * objsize < SCV_MIN_ALLOC) {
-		capacity = (SCV_MIN_ALLOC + (objsize - 1)) / objsize;
+	/* Always skip at least one byte to store the offset in */
+	offset = SCV_CACHE_LINE - ((size_t) block & (SCV_CACHE_LINE - 1));
+
+	block[offset - 1] = (char) (unsigned char) offset;
+
+	return block + offset;
+#endif
+}
+
+/**
+ * Free block at `ptr` allocated by `scv_i_small_alloc()`.
+ *
+ * @param ptr pointer to block
+ */
+static void scv_i_small_free(void *ptr)
+{
+#if defined(SCV_HAVE_POSIX_MEMALIGN)
+	free(ptr);
+#else
+	unsigned char *p = (unsigned char *) ptr;
+
+	free(p - p[-1]);
+#endif
+}
+
+/**
+ * Check if `v` uses inline storage allocated together with the structure.
+ */
+#define SCV_IS_INLINE(v) \
+	(((v)->flags & SCV_I_BORROWED) \
+	 && (char *) (v)->data - SCV_OFFSET(v) == (char *) (v) + SCV_SMALL_HDR)
+
+/**
+ * Default size of arena blocks in bytes.
+ */
+#define SCV_ARENA_BLOCKSIZE (65536u)
+
+/**
+ * Block of memory owned by an arena.
+ *
+ * The usable memory follows the structure, at offset
+ * `SCV_ALIGN_UP(sizeof(struct scv_i_arena_block), SCV_MAX_ALIGN)`.
+ */
+struct scv_i_arena_block {
+	struct scv_i_arena_block *next; /**< Previous block. */
+	size_t size;                    /**< Usable size in bytes. */
+	size_t used;                    /**< Used size in bytes. */
+};
+
+struct scv_arena {
+	struct scv_allocator allocator; /**< Allocator using this arena. */
+	struct scv_i_arena_block *head; /**< Current block. */
+	char *last;                     /**< Most recent allocation, or `NULL`. */
+	size_t blocksize;               /**< Default block size in bytes. */
+};
+
+#define SCV_ARENA_HDR SCV_ALIGN_UP(sizeof(struct scv_i_arena_block), SCV_MAX_ALIGN)
+
+#define SCV_ARENA_MEM(block) ((char *) (block) + SCV_ARENA_HDR)
+
+/**
+ * Add a new block of at least `size` usable bytes to `arena`.
+ *
+ * @param arena pointer to `scv_arena`
+ * @param size requested size in bytes
+ * @return zero on success, error code on error
+ */
+static int scv_i_arena_add_block(struct scv_arena *arena, size_t size)
+{
+	struct scv_i_arena_block *block;
+
+	if (size < arena->blocksize) {
+		size = arena->blocksize;
+	}
+
+	if (size > (size_t) -1 - SCV_ARENA_HDR - SCV_MAX_ALIGN) {
+		return SCV_ERANGE;
+	}
+
+	/* Keep the end of the block aligned, so rounded allocation sizes,
+	 * including in-place resizes, always fit */
+	size = SCV_ALIGN_UP(size, SCV_MAX_ALIGN);
+
+	block = (struct scv_i_arena_block *) malloc(SCV_ARENA_HDR + size);
+
+	if (block == NULL) {
+		return SCV_ENOMEM;
 	}
 
-	v->data = malloc(capacity * objsize);
+	block->next = arena->head;
+	block->size = size;
+	block->used = 0;
+
+	arena->head = block;
+	arena->last = NULL;
+
+	return SCV_OK;
+}
+
+static void *scv_i_arena_allocate(void *ctx, size_t size)
+{
+	struct scv_arena *arena = (struct scv_arena *) ctx;
+	struct scv_i_arena_block *block;
 
-	if (v->data == NULL) {
-		free(v);
+	if (size > (size_t) -1 - SCV_MAX_ALIGN) {
 		return NULL;
 	}
 
-	v->objsize = objsize;
-	v->size = 0;
-	v->capacity = capacity;
+	size = SCV_ALIGN_UP(size, SCV_MAX_ALIGN);
 
-	return v;
+	block = arena->head;
+
+	if (block == NULL || block->size - block->used < size) {
+		if (scv_i_arena_add_block(arena, size) != SCV_OK) {
+			return NULL;
+		}
+
+		block = arena->head;
+	}
+
+	arena->last = SCV_ARENA_MEM(block) + block->used;
+	block->used += size;
+
+	return arena->last;
 }
 
-void scv_delete(struct scv_vector *v)
+static void *scv_i_arena_reallocate(void *ctx, void *ptr, size_t oldsize, size_t newsize)
 {
-	if (v == NULL) {
-		return;
+	struct scv_arena *arena = (struct scv_arena *) ctx;
+	void *newptr;
+
+	/* Resize most recent allocation in place if possible */
+	if (ptr != NULL && ptr == arena->last) {
+		struct scv_i_arena_block *block = arena->head;
+		size_t offset = (size_t) ((char *) ptr - SCV_ARENA_MEM(block));
+
+		if (newsize <= block->size - offset) {
+			block->used = offset + SCV_ALIGN_UP(newsize, SCV_MAX_ALIGN);
+			return ptr;
+		}
 	}
+	else if (newsize <= oldsize) {
+		return ptr;
+	}
+
+	newptr = scv_i_arena_allocate(ctx, newsize);
 
-	if (v->data != NULL) {
-		free(v->data);
-		v->data = NULL;
+	if (newptr != NULL && ptr != NULL) {
+		memcpy(newptr, ptr, oldsize < newsize ? oldsize : newsize);
 	}
 
-	v->objsize = 0;
-	v->size = 0;
-	v->capacity = 0;
+	return newptr;
+}
+
+static void scv_i_arena_deallocate(void *ctx, void *ptr, size_t size)
+{
+	struct scv_arena *arena = (struct scv_arena *) ctx;
 
-	free(v);
+	(void) size;
+
+	/* Only the most recent allocation can be returned to the block */
+	if (ptr != NULL && ptr == arena->last) {
+		arena->head->used = (size_t) ((char *) ptr - SCV_ARENA_MEM(arena->head));
+		arena->last = NULL;
+	}
 }
 
-void *scv_at(struct scv_vector *v, size_t i)
+/**
+ * Return number of extra bytes allocated for alignment of `v`.
+ */
+#define SCV_SLACK(v) (SCV_ALIGNMENT(v) > 1 ? SCV_ALIGNMENT(v) - 1 : 0)
+
+/**
+ * Return size in bytes of the block of memory used by `v`.
+ */
+#define SCV_BLOCK_SIZE(v) \
+	((SCV_FRONT(v) + (v)->capacity) * (v)->objsize + SCV_SLACK(v))
+
+/**
+ * Return offset from `block` to the next multiple of `alignment`.
+ *
+ * @param block pointer to memory
+ * @param alignment alignment in bytes, zero or a power of two
+ * @return offset in bytes
+ */
+static size_t scv_i_align_offset(const char *block, size_t alignment)
 {
-	assert(v != NULL);
-	assert(v->data != NULL);
+	if (alignment <= 1) {
+		return 0;
+	}
 
-	if (i >= v->size) {
-		return NULL;
+	return ((size_t) 0 - (size_t) block) & (alignment - 1);
+}
+
+/**
+ * Return the number of elements of `v` that span a multiple of its
+ * alignment.
+ *
+ * Keeping the unused space before the elements a multiple of this keeps
+ * the elements aligned.
+ */
+static size_t scv_i_front_unit(const struct scv_vector *v)
+{
+	size_t unit = SCV_ALIGNMENT(v) > 1 ? SCV_ALIGNMENT(v) : 1;
+	size_t objsize = v->objsize;
+
+	while (unit > 1 && objsize % 2 == 0) {
+		unit /= 2;
+		objsize /= 2;
+	}
+
+	return unit;
+}
+
+/**
+ * Change the capacity of `v` to `capacity`.
+ *
+ * If `v` has no memory, or the memory used by `v` is borrowed, new memory
+ * is allocated and the elements copied to it.
+ *
+ * If `v` has an alignment, the elements are moved to the aligned position
+ * in the reallocated block if the allocator did not preserve it.
+ *
+ * Any unused space before the elements is kept. It is always a multiple
+ * of `scv_i_front_unit()` elements, so the elements stay aligned.
+ *
+ * @param v pointer to `scv_vector`
+ * @param capacity new capacity, at least `v->size`
+ * @return zero on success, error code on error
+ */
+static int scv_i_set_capacity(struct scv_vector *v, size_t capacity)
+{
+	size_t slack = SCV_SLACK(v);
+	size_t front = SCV_FRONT(v);
+	size_t old_offset = SCV_OFFSET(v);
+	size_t align;
+	size_t offset;
+	char *block;
+
+	assert(capacity >= v->size);
+	assert(v->objsize > 0);
+	assert(front % scv_i_front_unit(v) == 0);
+
+	if (front > ((size_t) -1 - slack) / v->objsize
+	 || capacity > ((size_t) -1 - slack) / v->objsize - front) {
+		return SCV_ERANGE;
+	}
+
+	if (v->data == NULL || (v->flags & SCV_I_BORROWED)) {
+		block = (char *) scv_i_alloc(SCV_ALLOCATOR(v),
+		                             (front + capacity) * v->objsize + slack);
+
+		if (block == NULL) {
+			return SCV_ENOMEM;
+		}
+
+		align = scv_i_align_offset(block, SCV_ALIGNMENT(v));
+		offset = align + front * v->objsize;
+
+		if (v->size > 0) {
+			memcpy(block + offset, v->data, v->size * v->objsize);
+			SCV_COUNT(v, moves, 1);
+			SCV_COUNT(v, bytes_copied, v->size * v->objsize);
+		}
+
+		v->flags &= ~SCV_I_BORROWED;
+	}
+	else {
+		block = (char *) scv_i_realloc(SCV_ALLOCATOR(v), (char *) v->data - old_offset,
+		                               SCV_BLOCK_SIZE(v),
+		                               (front + capacity) * v->objsize + slack);
+
+		if (block == NULL) {
+			return SCV_ENOMEM;
+		}
+
+		align = scv_i_align_offset(block, SCV_ALIGNMENT(v));
+		offset = align + front * v->objsize;
+
+		if (block != (char *) v->data - old_offset && v->size > 0) {
+			SCV_COUNT(v, moves, 1);
+			SCV_COUNT(v, bytes_copied, v->size * v->objsize);
+		}
+
+		/* Contents keep their offset in the block, realign if needed */
+		if (offset != old_offset && v->size > 0) {
+			memmove(block + offset, block + old_offset, v->size * v->objsize);
+			SCV_COUNT(v, bytes_moved, v->size * v->objsize);
+		}
+	}
+
+	if (capacity > v->capacity) {
+		SCV_COUNT(v, grows, 1);
+	}
+
+	/* Vectors without ext have no alignment and no space before data */
+	if (v->ext != NULL) {
+		v->ext->offset = align;
+		v->ext->front = front;
+	}
+
+	v->data = block + offset;
+	v->capacity = capacity;
+
+	SCV_PEAK(v);
+
+	return SCV_OK;
+}
+
+/**
+ * State of an incremental move of elements to new memory.
+ *
+ * Elements from `moved` up to, but not including, `size` are still in the
+ * old memory, all other elements are in the memory of the `scv_vector`.
+ */
+struct scv_i_move {
+	char *data;      /**< Pointer to elements in old memory. */
+	size_t offset;   /**< Offset of `data` from start of old block. */
+	size_t capacity; /**< Capacity of old memory in number of elements. */
+	size_t front;    /**< Unused elements before `data` in old memory. */
+	size_t size;     /**< Number of elements in old memory. */
+	size_t moved;    /**< Number of elements moved. */
+	int borrowed;    /**< Non-zero if old memory is not owned. */
+};
+
+/**
+ * Return a pointer to element number `i` of `v`, which may still be in
+ * old memory.
+ *
+ * @param v pointer to `scv_vector`
+ * @param i index
+ * @return pointer to element `i`
+ */
+static void *scv_i_ptr(const struct scv_vector *v, size_t i)
+{
+	const struct scv_i_move *m = SCV_MOVE(v);
+
+	if (m != NULL && i >= m->moved && i < m->size) {
+		return m->data + i * v->objsize;
+	}
+
+	return SCV_AT(v, i);
+}
+
+/**
+ * Copy `nobj` elements starting at element number `i` of `v` to `dst`.
+ *
+ * @param v pointer to `scv_vector`
+ * @param i start index
+ * @param nobj number of elements to copy
+ * @param dst pointer to destination
+ */
+static void scv_i_read(const struct scv_vector *v, size_t i, size_t nobj, void *dst)
+{
+	const struct scv_i_move *m = SCV_MOVE(v);
+	char *p = (char *) dst;
+
+	if (nobj == 0) {
+		return;
+	}
+
+	if (m == NULL || i + nobj <= m->moved || i >= m->size) {
+		memcpy(p, SCV_AT(v, i), nobj * v->objsize);
+		return;
+	}
+
+	/* Copy up to three parts, from new, old, and new memory */
+	if (i < m->moved) {
+		memcpy(p, SCV_AT(v, i), (m->moved - i) * v->objsize);
+		p += (m->moved - i) * v->objsize;
+		nobj -= m->moved - i;
+		i = m->moved;
+	}
+
+	if (i < m->size) {
+		size_t n = m->size - i < nobj ? m->size - i : nobj;
+
+		memcpy(p, m->data + i * v->objsize, n * v->objsize);
+		p += n * v->objsize;
+		nobj -= n;
+		i += n;
+	}
+
+	if (nobj > 0) {
+		memcpy(p, SCV_AT(v, i), nobj * v->objsize);
+	}
+}
+
+/**
+ * Free the old memory of an incremental move of `v`.
+ *
+ * @param v pointer to `scv_vector`
+ */
+static void scv_i_end_move(struct scv_vector *v)
+{
+	struct scv_i_move *m = SCV_MOVE(v);
+
+	if (!m->borrowed) {
+		scv_i_free(SCV_ALLOCATOR(v), m->data - m->offset,
+		           (m->front + m->capacity) * v->objsize + SCV_SLACK(v));
+	}
+
+	scv_i_free(SCV_ALLOCATOR(v), m, sizeof *m);
+
+	v->ext->move = NULL;
+	v->flags &= ~SCV_I_MOVING;
+}
+
+/**
+ * Move up to `nobj` elements of `v` from old memory.
+ *
+ * @param v pointer to `scv_vector`
+ * @param nobj maximum number of elements to move
+ */
+static void scv_i_move_step(struct scv_vector *v, size_t nobj)
+{
+	struct scv_i_move *m = SCV_MOVE(v);
+
+	assert(m != NULL);
+
+	if (nobj > m->size - m->moved) {
+		nobj = m->size - m->moved;
+	}
+
+	if (nobj > 0) {
+		memcpy(SCV_AT(v, m->moved), m->data + m->moved * v->objsize,
+		       nobj * v->objsize);
+		SCV_COUNT(v, bytes_copied, nobj * v->objsize);
+		m->moved += nobj;
+	}
+
+	if (m->moved == m->size) {
+		scv_i_end_move(v);
+	}
+}
+
+/**
+ * Stop moving elements of `v` from old memory that are past the end of `v`.
+ *
+ * @param v pointer to `scv_vector`
+ */
+static void scv_i_trim_move(struct scv_vector *v)
+{
+	struct scv_i_move *m = SCV_MOVE(v);
+
+	if (m != NULL && m->size > v->size) {
+		m->size = v->size > m->moved ? v->size : m->moved;
+
+		if (m->moved == m->size) {
+			scv_i_end_move(v);
+		}
+	}
+}
+
+/**
+ * Finish any incremental move of `v`, so all elements are in contiguous
+ * memory.
+ *
+ * @param v pointer to `scv_vector`
+ */
+static void scv_i_settle(struct scv_vector *v)
+{
+	if (v->flags & SCV_I_MOVING) {
+		scv_i_move_step(v, v->ext->move->size);
+	}
+}
+
+/**
+ * Start an incremental move of `v` to new memory of `capacity` elements.
+ *
+ * If the state or the new memory cannot be allocated, the memory is
+ * reallocated and all elements moved at once instead.
+ *
+ * @param v pointer to `scv_vector`
+ * @param capacity new capacity, at least `v->size`
+ * @return zero on success, error code on error
+ */
+static int scv_i_start_move(struct scv_vector *v, size_t capacity)
+{
+	size_t slack = SCV_SLACK(v);
+	struct scv_i_move *m;
+	char *block;
+
+	assert(!(v->flags & SCV_I_MOVING));
+	assert(capacity >= v->size);
+
+	if (v->data == NULL || v->size <= SCV_STEP(v)) {
+		return scv_i_set_capacity(v, capacity);
+	}
+
+	assert(v->ext != NULL);
+
+	if (capacity > ((size_t) -1 - slack) / v->objsize) {
+		return SCV_ERANGE;
+	}
+
+	m = (struct scv_i_move *) scv_i_alloc(v->ext->allocator, sizeof *m);
+
+	if (m == NULL) {
+		return scv_i_set_capacity(v, capacity);
+	}
+
+	block = (char *) scv_i_alloc(v->ext->allocator, capacity * v->objsize + slack);
+
+	if (block == NULL) {
+		scv_i_free(v->ext->allocator, m, sizeof *m);
+		return scv_i_set_capacity(v, capacity);
+	}
+
+	m->data = (char *) v->data;
+	m->offset = SCV_OFFSET(v);
+	m->capacity = v->capacity;
+	m->front = v->ext->front;
+	m->size = v->size;
+	m->moved = 0;
+	m->borrowed = (v->flags & SCV_I_BORROWED) != 0;
+
+	v->ext->offset = scv_i_align_offset(block, SCV_ALIGNMENT(v));
+	v->data = block + v->ext->offset;
+	v->capacity = capacity;
+	v->ext->front = 0;
+	v->flags &= ~SCV_I_BORROWED;
+	v->ext->move = m;
+	v->flags |= SCV_I_MOVING;
+
+	SCV_COUNT(v, grows, 1);
+	SCV_COUNT(v, moves, 1);
+	SCV_PEAK(v);
+
+	return SCV_OK;
+}
+
+/**
+ * Default threshold for mapping blocks in bytes.
+ */
+#define SCV_MMAP_THRESHOLD (1048576u)
+
+#if defined(SCV_HAVE_MREMAP)
+
+/**
+ * Return `size` rounded up to a multiple of the page size.
+ */
+static size_t scv_i_page_round(size_t size)
+{
+	static size_t pagesize = 0;
+
+	if (pagesize == 0) {
+		long res = sysconf(_SC_PAGESIZE);
+
+		pagesize = res > 0 ? (size_t) res : 4096u;
+	}
+
+	return SCV_ALIGN_UP(size, pagesize);
+}
+
+static void *scv_i_mmap_allocate(void *ctx, size_t size)
+{
+	struct scv_mmap_allocator *ma = (struct scv_mmap_allocator *) ctx;
+	void *p;
+
+	if (size < ma->threshold) {
+		return malloc(size);
+	}
+
+	p = mmap(NULL, scv_i_page_round(size), PROT_READ | PROT_WRITE,
+	         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	return p == MAP_FAILED ? NULL : p;
+}
+
+static void scv_i_mmap_deallocate(void *ctx, void *ptr, size_t size)
+{
+	struct scv_mmap_allocator *ma = (struct scv_mmap_allocator *) ctx;
+
+	if (size < ma->threshold) {
+		free(ptr);
+		return;
+	}
+
+	munmap(ptr, scv_i_page_round(size));
+}
+
+static void *scv_i_mmap_reallocate(void *ctx, void *ptr, size_t oldsize, size_t newsize)
+{
+	struct scv_mmap_allocator *ma = (struct scv_mmap_allocator *) ctx;
+	void *p;
+
+	if (ptr == NULL) {
+		return scv_i_mmap_allocate(ctx, newsize);
+	}
+
+	if (oldsize < ma->threshold && newsize < ma->threshold) {
+		return realloc(ptr, newsize);
+	}
+
+	if (oldsize >= ma->threshold && newsize >= ma->threshold) {
+		p = mremap(ptr, scv_i_page_round(oldsize), scv_i_page_round(newsize),
+		           MREMAP_MAYMOVE);
+
+		return p == MAP_FAILED ? NULL : p;
+	}
+
+	/* Crossing the threshold, so copy between malloc and mmap */
+	p = scv_i_mmap_allocate(ctx, newsize);
+
+	if (p != NULL) {
+		memcpy(p, ptr, oldsize < newsize ? oldsize : newsize);
+		scv_i_mmap_deallocate(ctx, ptr, oldsize);
+	}
+
+	return p;
+}
+
+#else /* SCV_HAVE_MREMAP */
+
+static void *scv_i_mmap_allocate(void *ctx, size_t size)
+{
+	(void) ctx;
+
+	return malloc(size);
+}
+
+static void *scv_i_mmap_reallocate(void *ctx, void *ptr, size_t oldsize, size_t newsize)
+{
+	(void) ctx;
+	(void) oldsize;
+
+	return realloc(ptr, newsize);
+}
+
+static void scv_i_mmap_deallocate(void *ctx, void *ptr, size_t size)
+{
+	(void) ctx;
+	(void) size;
+
+	free(ptr);
+}
+
+#endif /* SCV_HAVE_MREMAP */
+
+/**
+ * Default growth policy.
+ */
+static const struct scv_growth scv_i_default_growth = {
+	SCV_MIN_ALLOC, 200, 150, 4096, NULL, NULL
+};
+
+/**
+ * Return the growth policy of `v`.
+ */
+#define SCV_GROWTH(v) \
+	((v)->ext != NULL && (v)->ext->growth != NULL ? (v)->ext->growth : &scv_i_default_growth)
+
+/**
+ * Return the minimum capacity of `v` in number of elements.
+ *
+ * The minimum capacity is `min_alloc` bytes or 1 element.
+ *
+ * @param v pointer to `scv_vector`
+ * @return minimum capacity
+ */
+static size_t scv_i_min_capacity(const struct scv_vector *v)
+{
+	size_t min_alloc = SCV_GROWTH(v)->min_alloc;
+
+	if (min_alloc <= v->objsize) {
+		return 1;
+	}
+
+	return (min_alloc + (v->objsize - 1)) / v->objsize;
+}
+
+/**
+ * Return `capacity` multiplied by `factor` percent, saturating on overflow.
+ */
+static size_t scv_i_scale(size_t capacity, unsigned int factor)
+{
+	size_t extra;
+
+	if (factor <= 100) {
+		return capacity;
+	}
+
+	factor -= 100;
+
+	if (capacity / 100 >= (size_t) -1 / factor) {
+		return (size_t) -1;
+	}
+
+	extra = (capacity / 100) * factor + (capacity % 100) * factor / 100;
+
+	if (extra >= (size_t) -1 - capacity) {
+		return (size_t) -1;
+	}
+
+	/* Always make progress when growing */
+	return capacity + extra + 1;
+}
+
+/**
+ * Return the capacity to grow `v` to, given requested `capacity`.
+ *
+ * The result is `capacity`, but at least the current capacity of `v`
+ * multiplied by the factor given by the growth policy of `v`.
+ *
+ * @param v pointer to `scv_vector`
+ * @param capacity requested capacity, less than `(size_t) -1 / v->objsize`
+ * @return new capacity
+ */
+static size_t scv_i_next_capacity(const struct scv_vector *v, size_t capacity)
+{
+	const struct scv_growth *growth = SCV_GROWTH(v);
+	size_t newcapacity;
+
+	if (growth->next_capacity != NULL) {
+		newcapacity = growth->next_capacity(growth->ctx, v, capacity);
+	}
+	else if (v->capacity < growth->threshold / v->objsize) {
+		newcapacity = scv_i_scale(v->capacity, growth->small_factor);
+	}
+	else {
+		newcapacity = scv_i_scale(v->capacity, growth->large_factor);
+	}
+
+	if (newcapacity < scv_i_min_capacity(v)) {
+		newcapacity = scv_i_min_capacity(v);
+	}
+
+	if (capacity > newcapacity || newcapacity >= (size_t) -1 / v->objsize) {
+		newcapacity = capacity;
+	}
+
+	return newcapacity;
+}
+
+/**
+ * Move the elements of `v` to `front` elements from the start of its block.
+ *
+ * The total space in the block is unchanged, `front` must be at most
+ * `SCV_FRONT(v) + v->capacity - v->size`. If `front` is not zero, `v`
+ * must have an `scv_i_ext`.
+ *
+ * @param v pointer to `scv_vector`
+ * @param front new number of unused elements before the elements
+ */
+static void scv_i_set_front(struct scv_vector *v, size_t front)
+{
+	size_t old_front = SCV_FRONT(v);
+	size_t total = old_front + v->capacity;
+	char *data = (char *) v->data;
+
+	assert(!(v->flags & SCV_I_MOVING));
+	assert(front <= total - v->size);
+
+	if (front == old_front) {
+		return;
+	}
+
+	assert(v->ext != NULL);
+
+	/* The start of the block stays where it is */
+	if (front > old_front) {
+		data += (front - old_front) * v->objsize;
+	}
+	else {
+		data -= (old_front - front) * v->objsize;
+	}
+
+	if (v->size > 0) {
+		memmove(data, v->data, v->size * v->objsize);
+		SCV_COUNT(v, bytes_moved, v->size * v->objsize);
+	}
+
+	v->data = data;
+	v->ext->front = front;
+	v->capacity = total - front;
+}
+
+/**
+ * Reclaim the unused space before the elements of `v`, if that gives room
+ * for `capacity` elements.
+ *
+ * This is only done when `capacity` is at most half the block, so the
+ * elements moved are paid for by the removals that freed the space.
+ *
+ * @param v pointer to `scv_vector`
+ * @param capacity requested capacity
+ * @return non-zero if `v` now has room for `capacity` elements
+ */
+static int scv_i_reclaim_front(struct scv_vector *v, size_t capacity)
+{
+	size_t front = SCV_FRONT(v);
+
+	if (front == 0 || capacity > (front + v->capacity) / 2) {
+		return 0;
+	}
+
+	scv_i_set_front(v, 0);
+
+	return 1;
+}
+
+/**
+ * Make room for at least `nfront` unused elements before the elements
+ * of `v`.
+ *
+ * The elements are moved so the free space is split evenly between the
+ * front and the back of the block. If less than half the block would be
+ * free, `v` is grown first, following the growth policy of `v`.
+ *
+ * If `v` has an alignment, the space beyond `nfront` is rounded down to
+ * keep the elements aligned once `nfront` elements are inserted.
+ *
+ * Any incremental move of `v` is finished first, and the `scv_i_ext` of
+ * `v` allocated if needed.
+ *
+ * @param v pointer to `scv_vector`
+ * @param nfront requested number of unused elements
+ * @return zero on success, error code on error
+ */
+static int scv_i_grow_front(struct scv_vector *v, size_t nfront)
+{
+	size_t total;
+	size_t extra;
+
+	assert(v != NULL);
+	assert(v->objsize > 0);
+
+	scv_i_settle(v);
+
+	if (nfront <= SCV_FRONT(v)) {
+		return SCV_OK;
+	}
+
+	if (nfront >= (size_t) -1 / v->objsize - v->size) {
+		return SCV_ERANGE;
+	}
+
+	if (scv_i_get_ext(v) == NULL) {
+		return SCV_ENOMEM;
+	}
+
+	total = v->ext->front + v->capacity;
+
+	if (v->data == NULL || (v->flags & SCV_I_BORROWED)
+	 || v->size + nfront > total / 2) {
+		size_t newtotal = scv_i_next_capacity(v, v->size + nfront);
+		int res;
+
+		if (newtotal < total) {
+			newtotal = total;
+		}
+
+		/* Grow at the back, then split the space below */
+		res = scv_i_set_capacity(v, newtotal - v->ext->front);
+
+		if (res != SCV_OK) {
+			return res;
+		}
+
+		total = v->ext->front + v->capacity;
+	}
+
+	extra = (total - v->size - nfront) / 2;
+
+	scv_i_set_front(v, nfront + (extra - extra % scv_i_front_unit(v)));
+
+	return SCV_OK;
+}
+
+/**
+ * Grow the capacity of `v` to at least `capacity`.
+ *
+ * If there is enough unused space before the elements, it is reclaimed
+ * instead. Otherwise, grow `v` to `capacity`, but at least by the factor
+ * given by the growth policy of `v`.
+ *
+ * Any incremental move of `v` is finished first.
+ *
+ * @param v pointer to `scv_vector`
+ * @param capacity requested capacity
+ * @return zero on success, error code on error
+ */
+static int scv_i_grow(struct scv_vector *v, size_t capacity)
+{
+	assert(v != NULL);
+
+	scv_i_settle(v);
+
+	if (capacity <= v->capacity) {
+		return SCV_OK;
+	}
+
+	assert(v->objsize > 0);
+
+	if (capacity >= (size_t) -1 / v->objsize) {
+		return SCV_ERANGE;
+	}
+
+	if (scv_i_reclaim_front(v, capacity)) {
+		return SCV_OK;
+	}
+
+	return scv_i_set_capacity(v, scv_i_next_capacity(v, capacity));
+}
+
+struct scv_arena *scv_arena_new(size_t blocksize)
+{
+	struct scv_arena *arena;
+
+	arena = (struct scv_arena *) malloc(sizeof *arena);
+
+	if (arena == NULL) {
+		return NULL;
+	}
+
+	arena->allocator.allocate = scv_i_arena_allocate;
+	arena->allocator.reallocate = scv_i_arena_reallocate;
+	arena->allocator.deallocate = scv_i_arena_deallocate;
+	arena->allocator.ctx = arena;
+	arena->head = NULL;
+	arena->last = NULL;
+	arena->blocksize = blocksize > 0 ? blocksize : SCV_ARENA_BLOCKSIZE;
+
+	return arena;
+}
+
+void scv_arena_reset(struct scv_arena *arena)
+{
+	struct scv_i_arena_block *block;
+
+	assert(arena != NULL);
+
+	if (arena->head == NULL) {
+		return;
+	}
+
+	/* Keep the current block for reuse, free the rest */
+	block = arena->head->next;
+
+	while (block != NULL) {
+		struct scv_i_arena_block *next = block->next;
+
+		free(block);
+		block = next;
+	}
+
+	arena->head->next = NULL;
+	arena->head->used = 0;
+	arena->last = NULL;
+}
+
+void scv_arena_delete(struct scv_arena *arena)
+{
+	if (arena == NULL) {
+		return;
+	}
+
+	scv_arena_reset(arena);
+
+	free(arena->head);
+
+	free(arena);
+}
+
+const struct scv_allocator *scv_arena_allocator(struct scv_arena *arena)
+{
+	assert(arena != NULL);
+
+	return &arena->allocator;
+}
+
+void scv_mmap_allocator_init(struct scv_mmap_allocator *ma, size_t threshold)
+{
+	assert(ma != NULL);
+
+	ma->allocator.allocate = scv_i_mmap_allocate;
+	ma->allocator.reallocate = scv_i_mmap_reallocate;
+	ma->allocator.deallocate = scv_i_mmap_deallocate;
+	ma->allocator.ctx = ma;
+	ma->threshold = threshold > 0 ? threshold : SCV_MMAP_THRESHOLD;
+}
+
+/**
+ * Create a new `scv_vector`.
+ *
+ * @param objsize size of each element in bytes
+ * @param capacity initial capacity in number of elements
+ * @param allocator pointer to allocator, `NULL` for `malloc()`
+ * @param alignment alignment in bytes, zero or a power of two
+ * @return pointer to `scv_vector`, `NULL` on error
+ */
+static struct scv_vector *scv_i_new(size_t objsize, size_t capacity,
+                                    const struct scv_allocator *allocator,
+                                    size_t alignment)
+{
+	struct scv_vector *v;
+
+	/* There must be room for at least one element */
+	if (objsize == 0 || (size_t) -1 / objsize <= 1
+	 || capacity >= (size_t) -1 / objsize) {
+		return NULL;
+	}
+
+	v = (struct scv_vector *) scv_i_alloc(allocator, sizeof *v);
+
+	if (v == NULL) {
+		return NULL;
+	}
+
+	scv_init(v, objsize);
+
+	/* The allocator is kept in ext, allocated with the allocator */
+	if (allocator != NULL || alignment > 1) {
+		struct scv_i_ext *ext = (struct scv_i_ext *) scv_i_alloc(allocator, sizeof *ext);
+
+		if (ext == NULL) {
+			scv_i_free(allocator, v, sizeof *v);
+			return NULL;
+		}
+
+		ext->allocator = allocator;
+		ext->front = 0;
+		ext->alignment = alignment > 1 ? alignment : 0;
+		ext->offset = 0;
+		ext->growth = NULL;
+		ext->move = NULL;
+		ext->step = 0;
+
+		v->ext = ext;
+	}
+
+	/* Memory is allocated on first growth if capacity is zero */
+	if (capacity == 0) {
+		return v;
+	}
+
+	/* Minimum capacity is SCV_MIN_ALLOC bytes or 1 element */
+	if (capacity * objsize < SCV_MIN_ALLOC) {
+		capacity = (SCV_MIN_ALLOC + (objsize - 1)) / objsize;
+	}
+
+	if (scv_i_set_capacity(v, capacity) != SCV_OK) {
+		scv_delete(v);
+		return NULL;
+	}
+
+	return v;
+}
+
+struct scv_vector *scv_new(size_t objsize, size_t capacity)
+{
+	return scv_i_new(objsize, capacity, NULL, 0);
+}
+
+struct scv_vector *scv_new_with_allocator(size_t objsize, size_t capacity,
+                                          const struct scv_allocator *allocator)
+{
+	return scv_i_new(objsize, capacity, allocator, 0);
+}
+
+struct scv_vector *scv_new_aligned(size_t objsize, size_t capacity, size_t alignment)
+{
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+		return NULL;
+	}
+
+	return scv_i_new(objsize, capacity, NULL, alignment);
+}
+
+struct scv_vector *scv_new_small(size_t objsize, size_t capacity)
+{
+	struct scv_vector *v;
+
+	if (capacity == 0) {
+		capacity = 1;
+	}
+
+	if (objsize == 0
+	 || capacity >= ((size_t) -1 - SCV_SMALL_HDR - SCV_CACHE_LINE) / objsize) {
+		return NULL;
+	}
+
+	v = (struct scv_vector *) scv_i_small_alloc(SCV_SMALL_HDR + capacity * objsize);
+
+	if (v == NULL) {
+		return NULL;
+	}
+
+	scv_init_buffer(v, objsize, (char *) v + SCV_SMALL_HDR, capacity);
+
+	v->flags |= SCV_I_SMALL;
+
+	return v;
+}
+
+void scv_delete(struct scv_vector *v)
+{
+	const struct scv_allocator *allocator;
+	unsigned int small;
+
+	if (v == NULL) {
+		return;
+	}
+
+	/* Destroying v frees the ext holding the allocator and clears flags */
+	allocator = SCV_ALLOCATOR(v);
+	small = v->flags & SCV_I_SMALL;
+
+	scv_destroy(v);
+
+	if (small) {
+		scv_i_small_free(v);
+	}
+	else {
+		scv_i_free(allocator, v, sizeof *v);
+	}
+}
+
+int scv_init(struct scv_vector *v, size_t objsize)
+{
+	return scv_init_buffer(v, objsize, NULL, 0);
+}
+
+int scv_init_buffer(struct scv_vector *v, size_t objsize, void *buffer, size_t capacity)
+{
+	assert(v != NULL);
+
+	if (objsize == 0 || (size_t) -1 / objsize <= 1
+	 || capacity >= (size_t) -1 / objsize) {
+		return SCV_ERANGE;
+	}
+
+	if (buffer == NULL && capacity > 0) {
+		return SCV_EINVAL;
+	}
+
+	v->data = capacity > 0 ? buffer : NULL;
+	v->objsize = objsize;
+	v->size = 0;
+	v->capacity = capacity;
+	v->flags = capacity > 0 ? SCV_I_BORROWED : 0;
+	v->ext = NULL;
+
+#if defined(SCV_STATS)
+	memset(&v->stats, 0, sizeof v->stats);
+#endif
+
+	return SCV_OK;
+}
+
+void scv_destroy(struct scv_vector *v)
+{
+	if (v == NULL) {
+		return;
+	}
+
+	if (v->flags & SCV_I_MOVING) {
+		scv_i_end_move(v);
+	}
+
+	if (v->data != NULL && !(v->flags & SCV_I_BORROWED)) {
+		scv_i_free(SCV_ALLOCATOR(v), (char *) v->data - SCV_OFFSET(v), SCV_BLOCK_SIZE(v));
+	}
+
+	if (v->ext != NULL) {
+		scv_i_free(v->ext->allocator, v->ext, sizeof *v->ext);
+		v->ext = NULL;
+	}
+
+	v->data = NULL;
+	v->objsize = 0;
+	v->size = 0;
+	v->capacity = 0;
+	v->flags = 0;
+}
+
+void *scv_at(struct scv_vector *v, size_t i)
+{
+	assert(v != NULL);
+
+	if (i >= v->size) {
+		return NULL;
+	}
+
+	return scv_i_ptr(v, i);
+}
+
+void *scv_front(struct scv_vector *v)
+{
+	assert(v != NULL);
+
+	if (v->size == 0) {
+		return NULL;
+	}
+
+	return scv_i_ptr(v, 0);
+}
+
+void *scv_back(struct scv_vector *v)
+{
+	assert(v != NULL);
+
+	if (v->size == 0) {
+		return NULL;
+	}
+
+	return scv_i_ptr(v, v->size - 1);
+}
+
+void *scv_data(struct scv_vector *v)
+{
+	assert(v != NULL);
+
+	scv_i_settle(v);
+
+	if (v->size == 0) {
+		return NULL;
+	}
+
+	return v->data;
+}
+
+int scv_empty(const struct scv_vector *v)
+{
+	assert(v != NULL);
+
+	return v->size == 0;
+}
+
+size_t scv_size(const struct scv_vector *v)
+{
+	assert(v != NULL);
+
+	return v->size;
+}
+
+size_t scv_objsize(const struct scv_vector *v)
+{
+	assert(v != NULL);
+
+	return v->objsize;
+}
+
+int scv_reserve(struct scv_vector *v, size_t capacity)
+{
+	assert(v != NULL);
+
+	scv_i_settle(v);
+
+	if (capacity <= v->capacity) {
+		return SCV_OK;
+	}
+
+	assert(v->objsize > 0);
+
+	if (capacity >= (size_t) -1 / v->objsize) {
+		return SCV_ERANGE;
+	}
+
+	return scv_i_set_capacity(v, capacity);
+}
+
+size_t scv_capacity(const struct scv_vector *v)
+{
+	assert(v != NULL);
+
+	return v->capacity;
+}
+
+int scv_set_growth(struct scv_vector *v, const struct scv_growth *growth)
+{
+	assert(v != NULL);
+
+	if (growth != NULL && growth->next_capacity == NULL
+	 && (growth->small_factor < 100 || growth->large_factor < 100)) {
+		return SCV_EINVAL;
+	}
+
+	if (growth == NULL && v->ext == NULL) {
+		return SCV_OK;
+	}
+
+	if (scv_i_get_ext(v) == NULL) {
+		return SCV_ENOMEM;
+	}
+
+	v->ext->growth = growth;
+
+	return SCV_OK;
+}
+
+int scv_set_incremental(struct scv_vector *v, size_t step)
+{
+	assert(v != NULL);
+
+	if (step == 0) {
+		scv_i_settle(v);
+
+		if (v->ext == NULL) {
+			return SCV_OK;
+		}
+	}
+
+	if (scv_i_get_ext(v) == NULL) {
+		return SCV_ENOMEM;
+	}
+
+	v->ext->step = step;
+
+	return SCV_OK;
+}
+
+int scv_shrink_to_fit(struct scv_vector *v)
+{
+	size_t newcapacity;
+
+	assert(v != NULL);
+
+	scv_i_settle(v);
+
+	SCV_COUNT(v, shrinks, 1);
+
+	scv_i_set_front(v, 0);
+
+	/* Borrowed memory cannot be trimmed */
+	if (v->capacity == v->size || (v->flags & SCV_I_BORROWED)) {
+		return SCV_OK;
+	}
+
+	newcapacity = v->size;
+
+	assert(v->objsize > 0);
+	assert(newcapacity < (size_t) -1 / v->objsize);
+
+	if (newcapacity < scv_i_min_capacity(v)) {
+		newcapacity = scv_i_min_capacity(v);
+	}
+
+	if (newcapacity == v->capacity) {
+		return SCV_OK;
+	}
+
+	return scv_i_set_capacity(v, newcapacity);
+}
+
+int scv_clear(struct scv_vector *v)
+{
+	assert(v != NULL);
+
+	/* No elements are left to move */
+	if (v->flags & SCV_I_MOVING) {
+		scv_i_end_move(v);
+	}
+
+	v->size = 0;
+
+	scv_i_set_front(v, 0);
+
+	return SCV_OK;
+}
+
+int scv_assign(struct scv_vector *v, const void *data, size_t nobj)
+{
+	assert(v != NULL);
+
+	assert(v->objsize > 0);
+
+	if (nobj >= (size_t) -1 / v->objsize) {
+		return SCV_ERANGE;
+	}
+
+	/* All elements are replaced, so there is no need to move them */
+	if (v->flags & SCV_I_MOVING) {
+		scv_i_end_move(v);
+	}
+
+	if (nobj > v->capacity) {
+		int res = scv_i_grow(v, nobj);
+
+		if (res != SCV_OK) {
+			return res;
+		}
+	}
+
+	if (data != NULL && nobj > 0) {
+		memcpy(v->data, data, nobj * v->objsize);
+		SCV_COUNT(v, bytes_copied, nobj * v->objsize);
+	}
+
+	v->size = nobj;
+
+	return SCV_OK;
+}
+
+int scv_replace(struct scv_vector *v, size_t i, size_t j, const void *data, size_t nobj)
+{
+	assert(v != NULL);
+
+	if (i > j || j > v->size) {
+		return SCV_ERANGE;
+	}
+
+	assert(v->objsize > 0);
+
+	if (nobj >= (size_t) -1 / v->objsize - (v->size - (j - i))) {
+		return SCV_ERANGE;
+	}
+
+	scv_i_settle(v);
+
+	if (v->size - (j - i) + nobj > v->capacity) {
+		int res = scv_i_grow(v, v->size - (j - i) + nobj);
+
+		if (res != SCV_OK) {
+			return res;
+		}
+	}
+
+	if (j < v->size && i + nobj != j) {
+		memmove(SCV_AT(v, i + nobj), SCV_AT(v, j), (v->size - j) * v->objsize);
+		SCV_COUNT(v, bytes_moved, (v->size - j) * v->objsize);
+	}
+
+	if (data != NULL && nobj > 0) {
+		memcpy(SCV_AT(v, i), data, nobj * v->objsize);
+		SCV_COUNT(v, bytes_copied, nobj * v->objsize);
+	}
+
+	v->size = v->size - (j - i) + nobj;
+
+	return SCV_OK;
+}
+
+int scv_insert(struct scv_vector *v, size_t i, const void *data, size_t nobj)
+{
+	return scv_replace(v, i, i, data, nobj);
+}
+
+int scv_insert_batch(struct scv_vector *v, const size_t *positions,
+                     const void *data, size_t count)
+{
+	size_t src_end;
+	size_t dst_end;
+	size_t k;
+
+	assert(v != NULL);
+	assert(positions != NULL || count == 0);
+
+	assert(v->objsize > 0);
+
+	if (count == 0) {
+		return SCV_OK;
+	}
+
+	for (k = 0; k < count; ++k) {
+		if (positions[k] > v->size) {
+			return SCV_ERANGE;
+		}
+
+		if (k > 0 && positions[k] < positions[k - 1]) {
+			return SCV_EINVAL;
+		}
+	}
+
+	if (count >= (size_t) -1 / v->objsize - v->size) {
+		return SCV_ERANGE;
 	}
 
-	return SCV_AT(v, i);
-}
+	scv_i_settle(v);
 
-void *scv_front(struct scv_vector *v)
-{
-	assert(v != NULL);
-	assert(v->data != NULL);
+	if (v->size + count > v->capacity) {
+		int res = scv_i_grow(v, v->size + count);
 
-	if (v->size == 0) {
-		return NULL;
+		if (res != SCV_OK) {
+			return res;
+		}
 	}
 
-	return v->data;
-}
+	src_end = v->size;
+	dst_end = v->size + count;
 
-void *scv_back(struct scv_vector *v)
-{
-	assert(v != NULL);
-	assert(v->data != NULL);
+	/* Fill from the back, so each element is moved once */
+	for (k = count; k-- > 0; ) {
+		size_t nmove = src_end - positions[k];
 
-	if (v->size == 0) {
-		return NULL;
-	}
+		if (nmove > 0) {
+			memmove(SCV_AT(v, dst_end - nmove), SCV_AT(v, positions[k]),
+			        nmove * v->objsize);
+			SCV_COUNT(v, bytes_moved, nmove * v->objsize);
+		}
 
-	return SCV_AT(v, v->size - 1);
-}
+		dst_end -= nmove + 1;
+		src_end = positions[k];
 
-void *scv_data(struct scv_vector *v)
-{
-	assert(v != NULL);
-	assert(v->data != NULL);
+		if (data != NULL) {
+			memcpy(SCV_AT(v, dst_end), (const char *) data + k * v->objsize,
+			       v->objsize);
+		}
+	}
 
-	if (v->size == 0) {
-		return NULL;
+	if (data != NULL) {
+		SCV_COUNT(v, bytes_copied, count * v->objsize);
 	}
 
-	return v->data;
-}
+	assert(dst_end == src_end);
 
-int scv_empty(const struct scv_vector *v)
-{
-	assert(v != NULL);
-	assert(v->data != NULL);
+	v->size += count;
 
-	return v->size == 0;
+	return SCV_OK;
 }
 
-size_t scv_size(const struct scv_vector *v)
+int scv_erase(struct scv_vector *v, size_t i, size_t j)
 {
-	assert(v != NULL);
-	assert(v->data != NULL);
-
-	return v->size;
+	return scv_replace(v, i, j, NULL, 0);
 }
 
-size_t scv_objsize(const struct scv_vector *v)
+int scv_erase_if(struct scv_vector *v, int (*pred)(const void *elem, void *ctx), void *ctx)
 {
+	size_t start = 0;
+	size_t w = 0;
+	size_t i;
+
 	assert(v != NULL);
-	assert(v->data != NULL);
+	assert(pred != NULL);
 
-	return v->objsize;
+	scv_i_settle(v);
+
+	/* Elements from start to i are kept, and moved into place as a run
+	 * when an element to erase is found or the end is reached */
+	for (i = 0; i <= v->size; ++i) {
+		if (i < v->size && !pred(SCV_AT(v, i), ctx)) {
+			continue;
+		}
+
+		if (start != w && i > start) {
+			memmove(SCV_AT(v, w), SCV_AT(v, start), (i - start) * v->objsize);
+			SCV_COUNT(v, bytes_moved, (i - start) * v->objsize);
+		}
+
+		w += i - start;
+		start = i + 1;
+	}
+
+	v->size = w;
+
+	return SCV_OK;
 }
 
-int scv_reserve(struct scv_vector *v, size_t capacity)
+int scv_erase_indices(struct scv_vector *v, const size_t *indices, size_t count)
 {
-	void *newdata;
+	size_t w;
+	size_t k;
 
 	assert(v != NULL);
-	assert(v->data != NULL);
+	assert(indices != NULL || count == 0);
 
-	if (capacity <= v->capacity) {
+	if (count == 0) {
 		return SCV_OK;
 	}
 
-	assert(v->objsize > 0);
+	for (k = 0; k < count; ++k) {
+		if (indices[k] >= v->size) {
+			return SCV_ERANGE;
+		}
 
-	if (capacity >= (size_t) -1 / v->objsize) {
-		return SCV_ERANGE;
+		if (k > 0 && indices[k] <= indices[k - 1]) {
+			return SCV_EINVAL;
+		}
 	}
 
-	newdata = realloc(v->data, capacity * v->objsize);
+	scv_i_settle(v);
 
-	if (newdata == NULL) {
-		return SCV_ENOMEM;
+	w = indices[0];
+
+	for (k = 0; k < count; ++k) {
+		size_t start = indices[k] + 1;
+		size_t end = k + 1 < count ? indices[k + 1] : v->size;
+
+		/* Move run of kept elements between removed ones into place */
+		if (end > start) {
+			memmove(SCV_AT(v, w), SCV_AT(v, start), (end - start) * v->objsize);
+			SCV_COUNT(v, bytes_moved, (end - start) * v->objsize);
+		}
+
+		w += end - start;
 	}
 
-	v->data = newdata;
-	v->capacity = capacity;
+	v->size = w;
 
 	return SCV_OK;
 }
 
-size_t scv_capacity(const struct scv_vector *v)
+int scv_swap_remove(struct scv_vector *v, size_t i)
 {
-	assert(v != NULL);
-	assert(v->data != NULL);
-
-	return v->capacity;
+	return scv_swap_remove_indices(v, &i, 1);
 }
 
-int scv_shrink_to_fit(struct scv_vector *v)
+int scv_swap_remove_indices(struct scv_vector *v, const size_t *indices, size_t count)
 {
-	void *newdata;
-	size_t newcapacity;
+	size_t k;
 
 	assert(v != NULL);
-	assert(v->data != NULL);
+	assert(indices != NULL || count == 0);
 
-	if (v->capacity == v->size) {
-		return SCV_OK;
-	}
-
-	newcapacity = v->size;
-
-	assert(v->objsize > 0);
-	assert(newcapacity < (size_t) -1 / v->objsize);
+	for (k = 0; k < count; ++k) {
+		if (indices[k] >= v->size) {
+			return SCV_ERANGE;
+		}
 
-	/* Minimum capacity is SCV_MIN_ALLOC bytes or 1 element */
-	if (newcapacity * v->objsize < SCV_MIN_ALLOC) {
-		newcapacity = (SCV_MIN_ALLOC + (v->objsize - 1)) / v->objsize;
+		if (k > 0 && indices[k] <= indices[k - 1]) {
+			return SCV_EINVAL;
+		}
 	}
 
-	newdata = realloc(v->data, newcapacity * v->objsize);
+	/* Elements may still be in old memory, so use scv_i_ptr */
+	for (k = count; k-- > 0; ) {
+		if (indices[k] != v->size - 1) {
+			memcpy(scv_i_ptr(v, indices[k]), scv_i_ptr(v, v->size - 1), v->objsize);
+			SCV_COUNT(v, bytes_copied, v->objsize);
+		}
 
-	if (newdata == NULL) {
-		return SCV_ENOMEM;
+		v->size -= 1;
 	}
 
-	v->data = newdata;
-	v->capacity = newcapacity;
+	scv_i_trim_move(v);
 
 	return SCV_OK;
 }
 
-int scv_clear(struct scv_vector *v)
+int scv_push_back(struct scv_vector *v, const void *data)
 {
 	assert(v != NULL);
-	assert(v->data != NULL);
-
-	v->size = 0;
 
-	return SCV_OK;
-}
+	if (v->flags & SCV_I_MOVING) {
+		scv_i_move_step(v, v->ext->step);
+	}
 
-int scv_assign(struct scv_vector *v, const void *data, size_t nobj)
-{
-	assert(v != NULL);
-	assert(v->data != NULL);
+	if (v->size + 1 > v->capacity) {
+		int res;
 
-	assert(v->objsize > 0);
+		if (SCV_STEP(v) > 0) {
+			scv_i_settle(v);
 
-	if (nobj >= (size_t) -1 / v->objsize) {
-		return SCV_ERANGE;
-	}
+			if (v->size + 1 >= (size_t) -1 / v->objsize) {
+				return SCV_ERANGE;
+			}
 
-	if (nobj > v->capacity) {
-		int res = scv_i_grow(v, nobj);
+			res = scv_i_reclaim_front(v, v->size + 1) ? SCV_OK
+			    : scv_i_start_move(v, scv_i_next_capacity(v, v->size + 1));
+		}
+		else {
+			res = scv_i_grow(v, v->size + 1);
+		}
 
 		if (res != SCV_OK) {
 			return res;
 		}
 	}
 
-	if (data != NULL && nobj > 0) {
-		memcpy(v->data, data, nobj * v->objsize);
+	assert(v->objsize > 0);
+
+	if (data != NULL) {
+		memcpy(SCV_AT(v, v->size), data, v->objsize);
+		SCV_COUNT(v, bytes_copied, v->objsize);
 	}
 
-	v->size = nobj;
+	v->size += 1;
 
 	return SCV_OK;
 }
 
-int scv_replace(struct scv_vector *v, size_t i, size_t j, const void *data, size_t nobj)
+void *scv_emplace_back_n(struct scv_vector *v, size_t n)
 {
-	assert(v != NULL);
-	assert(v->data != NULL);
+	void *p;
 
-	if (i > j || j > v->size) {
-		return SCV_ERANGE;
-	}
+	assert(v != NULL);
 
 	assert(v->objsize > 0);
 
-	if (nobj >= (size_t) -1 / v->objsize - (v->size - (j - i))) {
-		return SCV_ERANGE;
+	if (n == 0 || n >= (size_t) -1 / v->objsize - v->size) {
+		return NULL;
 	}
 
-	if (v->size - (j - i) + nobj > v->capacity) {
-		int res = scv_i_grow(v, v->size - (j - i) + nobj);
-
-		if (res != SCV_OK) {
-			return res;
+	if (v->size + n > v->capacity) {
+		if (scv_i_grow(v, v->size + n) != SCV_OK) {
+			return NULL;
 		}
 	}
 
-	if (j < v->size && i + nobj != j) {
-		memmove(SCV_AT(v, i + nobj), SCV_AT(v, j), (v->size - j) * v->objsize);
-	}
+	/* New elements are always in the current memory */
+	p = SCV_AT(v, v->size);
 
-	if (data != NULL && nobj > 0) {
-		memcpy(SCV_AT(v, i), data, nobj * v->objsize);
+	v->size += n;
+
+	return p;
+}
+
+int scv_emplace_back_commit(struct scv_vector *v, size_t n, size_t nfilled)
+{
+	assert(v != NULL);
+
+	if (nfilled > n || n > v->size) {
+		return SCV_ERANGE;
 	}
 
-	v->size = v->size - (j - i) + nobj;
+	v->size -= n - nfilled;
+
+	scv_i_trim_move(v);
 
 	return SCV_OK;
 }
 
-int scv_insert(struct scv_vector *v, size_t i, const void *data, size_t nobj)
+int scv_pop_back(struct scv_vector *v)
 {
-	return scv_replace(v, i, i, data, nobj);
-}
+	assert(v != NULL);
 
-int scv_erase(struct scv_vector *v, size_t i, size_t j)
-{
-	return scv_replace(v, i, j, NULL, 0);
+	if (v->size == 0) {
+		return SCV_ERANGE;
+	}
+
+	v->size -= 1;
+
+	/* Do not move the removed element */
+	scv_i_trim_move(v);
+
+	return SCV_OK;
 }
 
-int scv_push_back(struct scv_vector *v, const void *data)
+int scv_push_front(struct scv_vector *v, const void *data)
 {
+	size_t unit;
+
 	assert(v != NULL);
-	assert(v->data != NULL);
+	assert(v->objsize > 0);
 
-	if (v->size + 1 > v->capacity) {
-		int res = scv_i_grow(v, v->size + 1);
+	/* The space before the elements is kept a multiple of unit elements,
+	 * so the elements stay aligned */
+	unit = scv_i_front_unit(v);
+
+	if (SCV_FRONT(v) < unit) {
+		int res = scv_i_grow_front(v, unit);
 
 		if (res != SCV_OK) {
 			return res;
 		}
 	}
+	else {
+		scv_i_settle(v);
+	}
 
-	assert(v->objsize > 0);
+	assert(SCV_FRONT(v) % unit == 0);
+
+	/* Take unit elements of the space, moving the elements down to
+	 * follow the new first element */
+	if (unit > 1 && v->size > 0) {
+		memmove((char *) v->data - (unit - 1) * v->objsize, v->data,
+		        v->size * v->objsize);
+		SCV_COUNT(v, bytes_moved, v->size * v->objsize);
+	}
+
+	v->data = (char *) v->data - unit * v->objsize;
+	v->ext->front -= unit;
+	v->capacity += unit;
 
 	if (data != NULL) {
-		memcpy(SCV_AT(v, v->size), data, v->objsize);
+		memcpy(v->data, data, v->objsize);
+		SCV_COUNT(v, bytes_copied, v->objsize);
 	}
 
 	v->size += 1;
@@ -398,24 +2086,43 @@ int scv_push_back(struct scv_vector *v, const void *data)
 	return SCV_OK;
 }
 
-int scv_pop_back(struct scv_vector *v)
+int scv_pop_front(struct scv_vector *v)
 {
 	assert(v != NULL);
-	assert(v->data != NULL);
 
 	if (v->size == 0) {
 		return SCV_ERANGE;
 	}
 
+	scv_i_settle(v);
+
 	v->size -= 1;
 
+	/* Reuse the whole block once empty, without moving anything */
+	if (v->size == 0) {
+		scv_i_set_front(v, 0);
+		return SCV_OK;
+	}
+
+	/* If the space before data cannot be a single element, because that
+	 * would break the alignment, or cannot be recorded, move the rest
+	 * down instead */
+	if (scv_i_front_unit(v) > 1 || scv_i_get_ext(v) == NULL) {
+		memmove(v->data, SCV_AT(v, 1), v->size * v->objsize);
+		SCV_COUNT(v, bytes_moved, v->size * v->objsize);
+		return SCV_OK;
+	}
+
+	v->data = (char *) v->data + v->objsize;
+	v->ext->front += 1;
+	v->capacity -= 1;
+
 	return SCV_OK;
 }
 
 int scv_resize(struct scv_vector *v, size_t size)
 {
 	assert(v != NULL);
-	assert(v->data != NULL);
 
 	assert(v->objsize > 0);
 
@@ -433,23 +2140,109 @@ int scv_resize(struct scv_vector *v, size_t size)
 
 	v->size = size;
 
+	scv_i_trim_move(v);
+
 	return SCV_OK;
 }
 
 int scv_copy(struct scv_vector *dst, const struct scv_vector *src)
 {
 	assert(dst != NULL);
-	assert(dst->data != NULL);
 	assert(src != NULL);
-	assert(src->data != NULL);
 
 	if (dst == src || dst->objsize != src->objsize) {
 		return SCV_EINVAL;
 	}
 
+	if (src->flags & SCV_I_MOVING) {
+		int res = scv_assign(dst, NULL, src->size);
+
+		if (res == SCV_OK) {
+			scv_i_read(src, 0, src->size, dst->data);
+			SCV_COUNT(dst, bytes_copied, src->size * src->objsize);
+		}
+
+		return res;
+	}
+
 	return scv_assign(dst, src->data, src->size);
 }
 
+int scv_append(struct scv_vector *dst, const struct scv_vector *src)
+{
+	return scv_append_many(dst, &src, 1);
+}
+
+int scv_append_many(struct scv_vector *dst, const struct scv_vector *const *srcs, size_t count)
+{
+	size_t size;
+	size_t total;
+	size_t k;
+	char *p;
+
+	assert(dst != NULL);
+	assert(srcs != NULL || count == 0);
+
+	assert(dst->objsize > 0);
+
+	size = dst->size;
+	total = size;
+
+	for (k = 0; k < count; ++k) {
+		const struct scv_vector *src = srcs[k];
+
+		assert(src != NULL);
+
+		if (src->objsize != dst->objsize) {
+			return SCV_EINVAL;
+		}
+
+		/* If src is dst, its size is the size before the call */
+		if (src->size >= (size_t) -1 / dst->objsize - total) {
+			return SCV_ERANGE;
+		}
+
+		total += src == dst ? size : src->size;
+	}
+
+	scv_i_settle(dst);
+
+	if (total > dst->capacity) {
+		int res = scv_i_grow(dst, total);
+
+		if (res != SCV_OK) {
+			return res;
+		}
+	}
+
+	p = (char *) SCV_AT(dst, size);
+
+	for (k = 0; k < count; ++k) {
+		const struct scv_vector *src = srcs[k];
+
+		if (src == dst) {
+			if (size > 0) {
+				memcpy(p, dst->data, size * dst->objsize);
+			}
+
+			p += size * dst->objsize;
+
+			SCV_COUNT(dst, bytes_copied, size * dst->objsize);
+		}
+		else {
+			scv_i_read(src, 0, src->size, p);
+
+			p += src->size * dst->objsize;
+
+			SCV_COUNT(dst, bytes_copied, src->size * dst->objsize);
+		}
+	}
+
+	dst->size = total;
+
+	return SCV_OK;
+}
+
 int scv_swap(struct scv_vector *scv1, struct scv_vector *scv2)
 {
 	struct scv_vector tmp;
@@ -457,9 +2250,76 @@ int scv_swap(struct scv_vector *scv1, struct scv_vector *scv2)
 	assert(scv1 != NULL);
 	assert(scv2 != NULL);
 
+	/* The structures stay where they are, so each must keep the
+	 * allocator that scv_delete() frees it with */
+	if (SCV_ALLOCATOR(scv1) != SCV_ALLOCATOR(scv2)) {
+		return SCV_EINVAL;
+	}
+
+	scv_i_settle(scv1);
+	scv_i_settle(scv2);
+
+	/* Inline storage belongs to the structure, so move it out first */
+	if (SCV_IS_INLINE(scv1)) {
+		int res = scv_i_set_capacity(scv1, scv1->capacity);
+
+		if (res != SCV_OK) {
+			return res;
+		}
+	}
+
+	if (SCV_IS_INLINE(scv2)) {
+		int res = scv_i_set_capacity(scv2, scv2->capacity);
+
+		if (res != SCV_OK) {
+			return res;
+		}
+	}
+
 	tmp = *scv1;
 	*scv1 = *scv2;
 	*scv2 = tmp;
 
+	/* Each structure keeps the flag telling scv_delete() how to free it */
+	if ((scv1->flags ^ scv2->flags) & SCV_I_SMALL) {
+		scv1->flags ^= SCV_I_SMALL;
+		scv2->flags ^= SCV_I_SMALL;
+	}
+
+	return SCV_OK;
+}
+
+int scv_stats_get(const struct scv_vector *v, struct scv_stats *stats)
+{
+	assert(stats != NULL);
+
+#if defined(SCV_STATS)
+	*stats = v != NULL ? v->stats : scv_i_global_stats;
+
+	return SCV_OK;
+#else
+	(void) v;
+
+	memset(stats, 0, sizeof *stats);
+
+	return SCV_ERROR;
+#endif
+}
+
+int scv_stats_reset(struct scv_vector *v)
+{
+#if defined(SCV_STATS)
+	if (v != NULL) {
+		memset(&v->stats, 0, sizeof v->stats);
+	}
+	else {
+		memset(&scv_i_global_stats, 0, sizeof scv_i_global_stats);
+	}
+
 	return SCV_OK;
+#else
+	(void) v;
+
+	return SCV_ERROR;
+#endif
 }
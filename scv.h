@@ -29,9 +29,79 @@
 extern "C" {
 #endif
 
+/**
+ * Structure describing a memory allocator.
+ *
+ * Each function is passed `ctx` as the first argument. `reallocate` and
+ * `deallocate` are also passed the size of the block, so the allocator
+ * does not have to keep track of it.
+ *
+ * @see scv_new_with_allocator
+ */
+struct scv_allocator {
+	/** Allocate `size` bytes, return `NULL` on error. */
+	void *(*allocate)(void *ctx, size_t size);
+	/** Resize block at `ptr` from `oldsize` to `newsize` bytes, return `NULL` on error. */
+	void *(*reallocate)(void *ctx, void *ptr, size_t oldsize, size_t newsize);
+	/** Free block at `ptr` of `size` bytes. */
+	void (*deallocate)(void *ctx, void *ptr, size_t size);
+	void *ctx; /**< User context passed to functions. */
+};
+
+struct scv_vector;
+
+struct scv_i_ext;
+
+/**
+ * Structure holding allocation and copy statistics.
+ *
+ * Statistics are only collected if `SCV_STATS` is defined, both when
+ * compiling scv and any code that includes `scv.h`.
+ *
+ * @see scv_stats_get
+ */
+struct scv_stats {
+	size_t grows;         /**< Number of times capacity was increased. */
+	size_t moves;         /**< Number of reallocations that moved the elements. */
+	size_t bytes_copied;  /**< Bytes copied, including by moving reallocations. */
+	size_t bytes_moved;   /**< Bytes moved within memory by `memmove()`. */
+	size_t peak_capacity; /**< Peak capacity in bytes. */
+	size_t shrinks;       /**< Number of calls to `scv_shrink_to_fit()`. */
+};
+
+/**
+ * Structure describing how a `scv_vector` grows.
+ *
+ * When a `scv_vector` needs more space, the capacity is multiplied by
+ * `small_factor` while it is below `threshold` bytes, and by
+ * `large_factor` otherwise. A factor of 100 means growing only to the
+ * requested capacity.
+ *
+ * If `next_capacity` is not `NULL`, it is called instead to compute the
+ * new capacity, which is increased to the requested capacity if smaller.
+ *
+ * @see scv_set_growth
+ */
+struct scv_growth {
+	size_t min_alloc;          /**< Minimum allocation size in bytes. */
+	unsigned int small_factor; /**< Growth factor in percent below `threshold`. */
+	unsigned int large_factor; /**< Growth factor in percent from `threshold`. */
+	size_t threshold;          /**< Size in bytes where `large_factor` starts. */
+	/** Return new capacity for `v` given requested `capacity`, or `NULL`. */
+	size_t (*next_capacity)(void *ctx, const struct scv_vector *v, size_t capacity);
+	void *ctx;                 /**< User context passed to `next_capacity`. */
+};
+
 /**
  * Structure representing a `scv_vector`.
  *
+ * The structure is 48 bytes on 64-bit platforms (without `SCV_STATS`),
+ * which leaves room for the first elements of a vector created with
+ * `scv_new_small()` on the same cache line. State that few vectors use,
+ * like the allocator, alignment, growth policy, unused space before the
+ * elements, and incremental growth, is allocated separately when first
+ * needed.
+ *
  * @see scv_new
  */
 struct scv_vector {
@@ -39,8 +109,19 @@ struct scv_vector {
 	size_t objsize;  /**< Size of each element in bytes. */
 	size_t size;     /**< Used size in number of elements. */
 	size_t capacity; /**< Capacity in number of elements. */
+	struct scv_i_ext *ext; /**< Allocator, alignment, growth and front space, or `NULL`. */
+	unsigned int flags; /**< Internal flags. */
+#if defined(SCV_STATS)
+	struct scv_stats stats; /**< Statistics for this vector. */
+#endif
 };
 
+/**
+ * Flag indicating that an incremental move is in progress, so some
+ * elements may still be in old memory.
+ */
+#define SCV_I_MOVING (1u << 1)
+
 /**
  * Status codes returned by some functions.
  */
@@ -52,17 +133,151 @@ typedef enum {
 	SCV_EINVAL = -4  /**< Invalid argument. */
 } scv_error_code;
 
+/**
+ * Opaque structure representing an arena allocator.
+ *
+ * @see scv_arena_new
+ */
+struct scv_arena;
+
+/**
+ * Create a new arena allocator.
+ *
+ * An arena allocates memory sequentially from large blocks, and releases
+ * all of it at once with `scv_arena_reset()` or `scv_arena_delete()`.
+ *
+ * Reallocating the most recent allocation is done in place if there is
+ * room in the current block.
+ *
+ * If `blocksize` is zero, a default block size is used.
+ *
+ * @param blocksize size of each block in bytes
+ * @return pointer to `scv_arena`, `NULL` on error
+ */
+struct scv_arena *scv_arena_new(size_t blocksize);
+
+/**
+ * Release all memory allocated from `arena`.
+ *
+ * Any `scv_vector` created using `arena` becomes invalid, and must not be
+ * used or passed to `scv_delete()`.
+ *
+ * @param arena pointer to `scv_arena`
+ */
+void scv_arena_reset(struct scv_arena *arena);
+
+/**
+ * Destroy `arena`, freeing all associated memory.
+ *
+ * Any `scv_vector` created using `arena` becomes invalid.
+ *
+ * @param arena pointer to `scv_arena`
+ */
+void scv_arena_delete(struct scv_arena *arena);
+
+/**
+ * Return allocator that allocates from `arena`.
+ *
+ * The returned pointer can be passed to `scv_new_with_allocator()`, and is
+ * valid until `arena` is destroyed.
+ *
+ * @param arena pointer to `scv_arena`
+ * @return pointer to allocator
+ */
+const struct scv_allocator *scv_arena_allocator(struct scv_arena *arena);
+
+/**
+ * Structure representing an allocator that maps large blocks.
+ *
+ * Blocks of at least `threshold` bytes are allocated directly using
+ * `mmap()`, and resized using `mremap()`, which moves pages instead of
+ * copying their contents. Smaller blocks use `malloc()`.
+ *
+ * On platforms without `mremap()`, all blocks use `malloc()`.
+ *
+ * @see scv_mmap_allocator_init
+ */
+struct scv_mmap_allocator {
+	struct scv_allocator allocator; /**< Allocator to pass to `scv_new_with_allocator()`. */
+	size_t threshold; /**< Minimum size in bytes of mapped blocks. */
+};
+
+/**
+ * Initialize `ma` to map blocks of at least `threshold` bytes.
+ *
+ * If `threshold` is zero, a default threshold is used.
+ *
+ * `threshold` must not be changed while any memory is allocated by `ma`.
+ *
+ * @param ma pointer to `scv_mmap_allocator`
+ * @param threshold minimum size in bytes of mapped blocks
+ */
+void scv_mmap_allocator_init(struct scv_mmap_allocator *ma, size_t threshold);
+
 /**
  * Create a new `scv_vector`.
  *
  * `capacity` is in number of elements.
  *
+ * If `capacity` is zero, no memory is allocated for elements until the
+ * vector first grows.
+ *
  * @param objsize size of each element in bytes
  * @param capacity initial capacity in number of elements
  * @return pointer to `scv_vector`, `NULL` on error
  */
 struct scv_vector *scv_new(size_t objsize, size_t capacity);
 
+/**
+ * Create a new `scv_vector` using `allocator` for all memory.
+ *
+ * Both the `scv_vector` structure and the elements are allocated using
+ * `allocator`, which must remain valid until `scv_delete()` is called.
+ *
+ * If `allocator` is `NULL`, `malloc()` is used.
+ *
+ * @param objsize size of each element in bytes
+ * @param capacity initial capacity in number of elements
+ * @param allocator pointer to allocator
+ * @return pointer to `scv_vector`, `NULL` on error
+ */
+struct scv_vector *scv_new_with_allocator(size_t objsize, size_t capacity,
+                                          const struct scv_allocator *allocator);
+
+/**
+ * Create a new `scv_vector` with elements aligned to `alignment` bytes.
+ *
+ * The pointer returned by `scv_data()` is a multiple of `alignment`, also
+ * after any operation that changes the capacity of the vector.
+ *
+ * @param objsize size of each element in bytes
+ * @param capacity initial capacity in number of elements
+ * @param alignment alignment in bytes, must be a power of two
+ * @return pointer to `scv_vector`, `NULL` on error
+ */
+struct scv_vector *scv_new_aligned(size_t objsize, size_t capacity, size_t alignment);
+
+/**
+ * Create a new `scv_vector` with inline storage for `capacity` elements.
+ *
+ * The `scv_vector` structure and the storage for the first `capacity`
+ * elements are allocated together in a single allocation. The elements
+ * are moved to separately allocated memory only if the vector grows
+ * beyond `capacity`.
+ *
+ * Unlike `scv_new()`, `capacity` is not rounded up to a minimum size.
+ *
+ * The allocation is aligned to a 64-byte cache line. The structure is 48
+ * bytes on 64-bit platforms (without `SCV_STATS`), and the inline storage
+ * starts directly after it, so the structure and the first 16 bytes of
+ * elements share one cache line.
+ *
+ * @param objsize size of each element in bytes
+ * @param capacity inline capacity in number of elements
+ * @return pointer to `scv_vector`, `NULL` on error
+ */
+struct scv_vector *scv_new_small(size_t objsize, size_t capacity);
+
 /**
  * Destroy `v`, freeing the associated memory.
  *
@@ -70,6 +285,47 @@ struct scv_vector *scv_new(size_t objsize, size_t capacity);
  */
 void scv_delete(struct scv_vector *v);
 
+/**
+ * Initialize the `scv_vector` structure at `v`.
+ *
+ * This allows a `scv_vector` to be placed on the stack or inside another
+ * structure. No memory is allocated until the vector first grows.
+ *
+ * Use `scv_destroy()` to free the associated memory.
+ *
+ * @param v pointer to `scv_vector` structure
+ * @param objsize size of each element in bytes
+ * @return zero on success, error code on error
+ */
+int scv_init(struct scv_vector *v, size_t objsize);
+
+/**
+ * Initialize the `scv_vector` structure at `v` to use `buffer`.
+ *
+ * `buffer` must have room for `capacity` elements, and be suitably aligned
+ * for them. It is used until the vector grows beyond `capacity`, at which
+ * point the elements are moved to allocated memory. `buffer` is never
+ * freed by scv.
+ *
+ * Use `scv_destroy()` to free any associated memory.
+ *
+ * @param v pointer to `scv_vector` structure
+ * @param objsize size of each element in bytes
+ * @param buffer pointer to memory for elements
+ * @param capacity capacity of `buffer` in number of elements
+ * @return zero on success, error code on error
+ */
+int scv_init_buffer(struct scv_vector *v, size_t objsize, void *buffer, size_t capacity);
+
+/**
+ * Free the memory allocated by `v`, without freeing `v` itself.
+ *
+ * This is the counterpart to `scv_init()` and `scv_init_buffer()`.
+ *
+ * @param v pointer to `scv_vector`.
+ */
+void scv_destroy(struct scv_vector *v);
+
 /**
  * Return a pointer to element number `i` of `v`.
  *
@@ -139,11 +395,61 @@ int scv_reserve(struct scv_vector *v, size_t capacity);
 /**
  * Return the capacity of `v`.
  *
+ * This does not include unused space before the first element, which is
+ * kept for `scv_push_front()`.
+ *
  * @param v pointer to `scv_vector`
  * @return capacity in number of elements
  */
 size_t scv_capacity(const struct scv_vector *v);
 
+/**
+ * Set the growth policy of `v`.
+ *
+ * `growth` must remain valid while it is used by `v`. If `growth` is
+ * `NULL`, the default policy is used, which has a minimum allocation of
+ * 64 bytes, and grows by a factor of 2 below 4096 bytes and 1.5 above.
+ *
+ * The policy is stored in a small block allocated for `v` the first time
+ * it is needed, so this can fail with `SCV_ENOMEM`.
+ *
+ * @param v pointer to `scv_vector`
+ * @param growth pointer to growth policy
+ * @return zero on success, error code on error
+ */
+int scv_set_growth(struct scv_vector *v, const struct scv_growth *growth);
+
+/**
+ * Enable incremental growth of `v`, moving `step` elements per operation.
+ *
+ * When `scv_push_back()` needs more space, new memory is allocated, but
+ * the existing elements are moved to it `step` at a time by later calls to
+ * `scv_push_back()`, instead of all at once. This bounds the time any
+ * single call takes. `scv_at()`, `scv_front()` and `scv_back()` return
+ * the element from where it currently is.
+ *
+ * Functions that need the elements in contiguous memory, like
+ * `scv_data()` and `scv_insert()`, finish moving any remaining elements
+ * first.
+ *
+ * `step` should be at least 2, so the move completes before the vector
+ * needs to grow again with the default growth policy.
+ *
+ * Both the old and the new memory are in use during a move. If the new
+ * memory or the state of the move cannot be allocated, the memory is
+ * reallocated and all elements moved at once, as without incremental
+ * growth, so `SCV_ENOMEM` is only returned if that also fails.
+ *
+ * If `step` is zero, incremental growth is disabled.
+ *
+ * Like `scv_set_growth()`, this can fail with `SCV_ENOMEM` the first time.
+ *
+ * @param v pointer to `scv_vector`
+ * @param step number of elements to move per operation
+ * @return zero on success, error code on error
+ */
+int scv_set_incremental(struct scv_vector *v, size_t step);
+
 /**
  * Trim the capacity of `v` to the number of elements used.
  *
@@ -210,6 +516,30 @@ int scv_replace(struct scv_vector *v, size_t i, size_t j, const void *data, size
  */
 int scv_insert(struct scv_vector *v, size_t i, const void *data, size_t nobj);
 
+/**
+ * Insert `count` elements from `data` at the positions in `positions`.
+ *
+ * Element number `k` of `data` is inserted before the element that was at
+ * index `positions[k]` before the call. A position can be `scv_size(v)`, in
+ * which case the element is added at the end. Elements inserted at the
+ * same position keep their order from `data`.
+ *
+ * `positions` must be sorted in increasing order. `v` grows at most once,
+ * and each existing element is moved at most once.
+ *
+ * If `data` is `NULL`, inserted elements are not initialized.
+ *
+ * `data` must not point inside `v`.
+ *
+ * @param v pointer to `scv_vector`
+ * @param positions array of insert positions
+ * @param data pointer to data to copy into new elements
+ * @param count number of elements to insert
+ * @return zero on success, error code on error
+ */
+int scv_insert_batch(struct scv_vector *v, const size_t *positions,
+                     const void *data, size_t count);
+
 /**
  * Remove elements from `i` up to, but not including, `j` from `v`.
  *
@@ -220,6 +550,62 @@ int scv_insert(struct scv_vector *v, size_t i, const void *data, size_t nobj);
  */
 int scv_erase(struct scv_vector *v, size_t i, size_t j);
 
+/**
+ * Remove all elements of `v` for which `pred` returns non-zero.
+ *
+ * `pred` is called once for each element, in order, with a pointer to the
+ * element and `ctx`. The remaining elements keep their order, and are
+ * moved in a single pass.
+ *
+ * @param v pointer to `scv_vector`
+ * @param pred predicate function
+ * @param ctx user context passed to `pred`
+ * @return zero on success, error code on error
+ */
+int scv_erase_if(struct scv_vector *v, int (*pred)(const void *elem, void *ctx), void *ctx);
+
+/**
+ * Remove the `count` elements at the positions in `indices` from `v`.
+ *
+ * `indices` must be sorted in strictly increasing order. The remaining
+ * elements keep their order, and are moved in a single pass.
+ *
+ * @param v pointer to `scv_vector`
+ * @param indices array of indices to remove
+ * @param count number of indices
+ * @return zero on success, error code on error
+ */
+int scv_erase_indices(struct scv_vector *v, const size_t *indices, size_t count);
+
+/**
+ * Remove element number `i` from `v` by moving the last element into it.
+ *
+ * This takes constant time, but does not preserve the order of elements.
+ *
+ * @param v pointer to `scv_vector`
+ * @param i index
+ * @return zero on success, error code on error
+ */
+int scv_swap_remove(struct scv_vector *v, size_t i);
+
+/**
+ * Remove the `count` elements at the positions in `indices` from `v` by
+ * moving elements from the end into them.
+ *
+ * `indices` must be sorted in strictly increasing order, and refer to
+ * positions before the call. Elements are removed from the highest index
+ * down, so an element that is moved is never one that is to be removed.
+ *
+ * This takes time proportional to `count`, but does not preserve the order
+ * of elements.
+ *
+ * @param v pointer to `scv_vector`
+ * @param indices array of indices to remove
+ * @param count number of indices
+ * @return zero on success, error code on error
+ */
+int scv_swap_remove_indices(struct scv_vector *v, const size_t *indices, size_t count);
+
 /**
  * Insert a single element from `data` at the end of `v`.
  *
@@ -233,6 +619,33 @@ int scv_erase(struct scv_vector *v, size_t i, size_t j);
  */
 int scv_push_back(struct scv_vector *v, const void *data);
 
+/**
+ * Append `n` uninitialized elements to `v`, and return a pointer to them.
+ *
+ * `v` grows at most once. The caller can then write the new elements
+ * directly into the vector. If fewer than `n` elements end up being used,
+ * call `scv_emplace_back_commit()` to remove the rest.
+ *
+ * The pointer is valid until a function causes a reallocation.
+ *
+ * @param v pointer to `scv_vector`
+ * @param n number of elements to append
+ * @return pointer to first new element, `NULL` on error or if `n` is zero
+ */
+void *scv_emplace_back_n(struct scv_vector *v, size_t n);
+
+/**
+ * Keep only the first `nfilled` of the last `n` elements of `v`.
+ *
+ * Used after `scv_emplace_back_n()` to commit a partial fill.
+ *
+ * @param v pointer to `scv_vector`
+ * @param n number of elements appended by `scv_emplace_back_n()`
+ * @param nfilled number of those elements to keep
+ * @return zero on success, error code on error
+ */
+int scv_emplace_back_commit(struct scv_vector *v, size_t n, size_t nfilled);
+
 /**
  * Remove the last element of `v`.
  *
@@ -241,6 +654,42 @@ int scv_push_back(struct scv_vector *v, const void *data);
  */
 int scv_pop_back(struct scv_vector *v);
 
+/**
+ * Insert a single element from `data` at the beginning of `v`.
+ *
+ * `v` keeps unused space before the first element, so this takes amortized
+ * constant time, like `scv_push_back()`. When that space runs out, the
+ * elements are moved to leave room at both ends.
+ *
+ * If `data` is `NULL`, the inserted element is not initialized.
+ *
+ * `data` must not point inside `v`.
+ *
+ * If `v` was created with `scv_new_aligned()` and `objsize` is not a
+ * multiple of the alignment, the elements are moved to keep `scv_data()`
+ * aligned, so this takes linear time.
+ *
+ * @param v pointer to `scv_vector`
+ * @param data pointer to data to copy into new element
+ * @return zero on success, error code on error
+ */
+int scv_push_front(struct scv_vector *v, const void *data);
+
+/**
+ * Remove the first element of `v`.
+ *
+ * The remaining elements are not moved, the space is kept for
+ * `scv_push_front()`, or reclaimed when `v` grows at the end.
+ *
+ * If `v` was created with `scv_new_aligned()` and `objsize` is not a
+ * multiple of the alignment, the remaining elements are moved to keep
+ * `scv_data()` aligned, so this takes linear time.
+ *
+ * @param v pointer to `scv_vector`
+ * @return zero on success, error code on error
+ */
+int scv_pop_front(struct scv_vector *v);
+
 /**
  * Resize the number of elements in `v`.
  *
@@ -261,15 +710,291 @@ int scv_resize(struct scv_vector *v, size_t size);
  */
 int scv_copy(struct scv_vector *dst, const struct scv_vector *src);
 
+/**
+ * Append the elements of `src` to `dst`.
+ *
+ * `src` can be the same as `dst`.
+ *
+ * @param dst pointer to destination `scv_vector`
+ * @param src pointer to source `scv_vector`
+ * @return zero on success, error code on error
+ */
+int scv_append(struct scv_vector *dst, const struct scv_vector *src);
+
+/**
+ * Append the elements of `count` vectors in `srcs` to `dst`.
+ *
+ * The final size is computed first, so `dst` grows at most once. Any of
+ * the vectors in `srcs` can be the same as `dst`, in which case the
+ * elements of `dst` before the call are appended.
+ *
+ * @param dst pointer to destination `scv_vector`
+ * @param srcs array of pointers to source `scv_vector`
+ * @param count number of vectors in `srcs`
+ * @return zero on success, error code on error
+ */
+int scv_append_many(struct scv_vector *dst, const struct scv_vector *const *srcs, size_t count);
+
 /**
  * Swap elements between `scv1` and `scv2`.
  *
+ * Both vectors must use the same allocator, since each structure is
+ * freed using its own allocator. Vectors with different allocators
+ * are left unchanged, and `SCV_EINVAL` is returned.
+ *
  * @param scv1 pointer to `scv_vector`
  * @param scv2 pointer to `scv_vector`
  * @return zero on success, error code on error
  */
 int scv_swap(struct scv_vector *scv1, struct scv_vector *scv2);
 
+/**
+ * Get statistics for `v`, or for all vectors if `v` is `NULL`.
+ *
+ * The global statistics are not updated atomically, so they are only
+ * accurate if vectors are not used concurrently from multiple threads.
+ *
+ * If scv is compiled without `SCV_STATS`, `stats` is cleared and an error
+ * is returned.
+ *
+ * @param v pointer to `scv_vector`, or `NULL`
+ * @param stats pointer to `scv_stats` to receive statistics
+ * @return zero on success, error code on error
+ */
+int scv_stats_get(const struct scv_vector *v, struct scv_stats *stats);
+
+/**
+ * Reset statistics for `v`, or the global statistics if `v` is `NULL`.
+ *
+ * @param v pointer to `scv_vector`, or `NULL`
+ * @return zero on success, error code on error
+ */
+int scv_stats_reset(struct scv_vector *v);
+
+#if defined(__cplusplus) || (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L)
+#  define SCV_INLINE static inline
+#elif defined(__GNUC__) || defined(_MSC_VER)
+#  define SCV_INLINE static __inline
+#else
+#  define SCV_INLINE static
+#endif
+
+/*
+ * Inline fast paths.
+ *
+ * If `SCV_INLINE_ACCESSORS` is defined before including `scv.h`, calls to
+ * `scv_at()`, `scv_front()`, `scv_back()`, `scv_data()`, `scv_empty()`,
+ * `scv_size()` and `scv_push_back()` are replaced by inline functions
+ * that handle the common case directly, and call the library functions
+ * otherwise. `scv_push_back()` only calls the library when it needs to grow.
+ *
+ * The library functions can still be called explicitly, for instance as
+ * `(scv_at)(v, i)`, or through function pointers.
+ */
+#if defined(SCV_INLINE_ACCESSORS)
+
+#include <string.h>
+
+SCV_INLINE void *scv_i_inline_at(struct scv_vector *v, size_t i)
+{
+	if (v->flags & SCV_I_MOVING) {
+		return (scv_at)(v, i);
+	}
+
+	return i < v->size ? (char *) v->data + i * v->objsize : NULL;
+}
+
+SCV_INLINE void *scv_i_inline_front(struct scv_vector *v)
+{
+	if (v->flags & SCV_I_MOVING) {
+		return (scv_front)(v);
+	}
+
+	return v->size > 0 ? v->data : NULL;
+}
+
+SCV_INLINE void *scv_i_inline_back(struct scv_vector *v)
+{
+	if (v->flags & SCV_I_MOVING) {
+		return (scv_back)(v);
+	}
+
+	return v->size > 0 ? (char *) v->data + (v->size - 1) * v->objsize : NULL;
+}
+
+SCV_INLINE void *scv_i_inline_data(struct scv_vector *v)
+{
+	if (v->flags & SCV_I_MOVING) {
+		return (scv_data)(v);
+	}
+
+	return v->size > 0 ? v->data : NULL;
+}
+
+SCV_INLINE int scv_i_inline_empty(const struct scv_vector *v)
+{
+	return v->size == 0;
+}
+
+SCV_INLINE size_t scv_i_inline_size(const struct scv_vector *v)
+{
+	return v->size;
+}
+
+SCV_INLINE int scv_i_inline_push_back(struct scv_vector *v, const void *data)
+{
+#if !defined(SCV_STATS)
+	if (v->size < v->capacity && !(v->flags & SCV_I_MOVING)) {
+		if (data != NULL) {
+			memcpy((char *) v->data + v->size * v->objsize, data, v->objsize);
+		}
+
+		v->size += 1;
+
+		return SCV_OK;
+	}
+#endif
+
+	return (scv_push_back)(v, data);
+}
+
+#define scv_at(v, i) scv_i_inline_at(v, i)
+#define scv_front(v) scv_i_inline_front(v)
+#define scv_back(v) scv_i_inline_back(v)
+#define scv_data(v) scv_i_inline_data(v)
+#define scv_empty(v) scv_i_inline_empty(v)
+#define scv_size(v) scv_i_inline_size(v)
+#define scv_push_back(v, data) scv_i_inline_push_back(v, data)
+
+#endif /* SCV_INLINE_ACCESSORS */
+
+#include <assert.h>
+
+#if defined(SCV_STATS)
+#  define SCV_I_FAST_PUSH 0
+#else
+#  define SCV_I_FAST_PUSH 1
+#endif
+
+/**
+ * Declare inline functions for a `scv_vector` of `type`.
+ *
+ * The functions are prefixed with `name`, and operate on a `scv_vector`
+ * with `objsize` equal to `sizeof(type)`. Since the element size is known
+ * at compile time, copies become plain assignments and index arithmetic
+ * is done on typed pointers:
+ *
+ *     SCV_DECLARE(intvec, int)
+ *
+ *     struct scv_vector *v = intvec_new(10);
+ *
+ *     intvec_push_back(v, 42);
+ *     *intvec_at(v, 0) += 1;
+ *
+ * The vectors are ordinary `scv_vector` objects, and can be used with
+ * all other functions. Each function asserts that `objsize` of the vector
+ * passed to it is `sizeof(type)`.
+ *
+ * `name_insert()` and `name_erase()` move elements with typed loops when
+ * `v` has the capacity needed, and call `scv_insert()` and `scv_erase()`
+ * otherwise.
+ *
+ * Declares `name_new()`, `name_init()`, `name_at()`, `name_front()`,
+ * `name_back()`, `name_data()`, `name_size()`, `name_push_back()`,
+ * `name_pop_back()`, `name_insert()` and `name_erase()`.
+ */
+#define SCV_DECLARE(name, type) \
+	SCV_INLINE struct scv_vector *name##_new(size_t capacity) \
+	{ \
+		return scv_new(sizeof(type), capacity); \
+	} \
+	SCV_INLINE int name##_init(struct scv_vector *v) \
+	{ \
+		return scv_init(v, sizeof(type)); \
+	} \
+	SCV_INLINE type *name##_at(struct scv_vector *v, size_t i) \
+	{ \
+		assert(scv_objsize(v) == sizeof(type)); \
+		if (v->flags & SCV_I_MOVING) { \
+			return (type *) (scv_at)(v, i); \
+		} \
+		return i < v->size ? (type *) v->data + i : (type *) 0; \
+	} \
+	SCV_INLINE type *name##_front(struct scv_vector *v) \
+	{ \
+		assert(scv_objsize(v) == sizeof(type)); \
+		return name##_at(v, 0); \
+	} \
+	SCV_INLINE type *name##_back(struct scv_vector *v) \
+	{ \
+		assert(scv_objsize(v) == sizeof(type)); \
+		return v->size > 0 ? name##_at(v, v->size - 1) : (type *) 0; \
+	} \
+	SCV_INLINE type *name##_data(struct scv_vector *v) \
+	{ \
+		assert(scv_objsize(v) == sizeof(type)); \
+		if (v->flags & SCV_I_MOVING) { \
+			return (type *) (scv_data)(v); \
+		} \
+		return v->size > 0 ? (type *) v->data : (type *) 0; \
+	} \
+	SCV_INLINE size_t name##_size(const struct scv_vector *v) \
+	{ \
+		assert(scv_objsize(v) == sizeof(type)); \
+		return v->size; \
+	} \
+	SCV_INLINE int name##_push_back(struct scv_vector *v, type value) \
+	{ \
+		assert(scv_objsize(v) == sizeof(type)); \
+		if (SCV_I_FAST_PUSH \
+		 && v->size < v->capacity && !(v->flags & SCV_I_MOVING)) { \
+			((type *) v->data)[v->size] = value; \
+			v->size += 1; \
+			return SCV_OK; \
+		} \
+		return (scv_push_back)(v, &value); \
+	} \
+	SCV_INLINE int name##_pop_back(struct scv_vector *v) \
+	{ \
+		assert(scv_objsize(v) == sizeof(type)); \
+		return (scv_pop_back)(v); \
+	} \
+	SCV_INLINE int name##_insert(struct scv_vector *v, size_t i, const type *data, size_t nobj) \
+	{ \
+		assert(scv_objsize(v) == sizeof(type)); \
+		if (SCV_I_FAST_PUSH && i <= v->size && nobj <= v->capacity - v->size \
+		 && !(v->flags & SCV_I_MOVING)) { \
+			type *p = (type *) v->data; \
+			size_t k; \
+			for (k = v->size; k > i; --k) { \
+				p[k - 1 + nobj] = p[k - 1]; \
+			} \
+			if (data != (const type *) 0) { \
+				for (k = 0; k < nobj; ++k) { \
+					p[i + k] = data[k]; \
+				} \
+			} \
+			v->size += nobj; \
+			return SCV_OK; \
+		} \
+		return scv_insert(v, i, data, nobj); \
+	} \
+	SCV_INLINE int name##_erase(struct scv_vector *v, size_t i, size_t j) \
+	{ \
+		assert(scv_objsize(v) == sizeof(type)); \
+		if (SCV_I_FAST_PUSH && i <= j && j <= v->size \
+		 && !(v->flags & SCV_I_MOVING)) { \
+			type *p = (type *) v->data; \
+			size_t k; \
+			for (k = j; k < v->size; ++k) { \
+				p[k - (j - i)] = p[k]; \
+			} \
+			v->size -= j - i; \
+			return SCV_OK; \
+		} \
+		return scv_erase(v, i, j); \
+	}
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,244 @@
+/*
+ * scv - Simple C Vector
+ *
+ * scv_gap.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "scv_gap.h"
+
+/*
+ * The elements are stored in the slots of `buf`, with `buf.size` being the
+ * total number of slots. Element `i` is in slot `i` if it is before the gap,
+ * and in slot `i + gapsize` otherwise.
+ */
+#define SCV_GAP_SLOT(g, i) ((char *) scv_data(&(g)->buf) + (i) * (g)->buf.objsize)
+
+/*
+ * Grow `g` so the gap can hold at least `nobj` elements.
+ *
+ * Uses the growth policy of `buf`, and makes all of the resulting capacity
+ * part of the gap.
+ */
+static int scv_gap_i_grow(struct scv_gap *g, size_t nobj)
+{
+	size_t oldslots = g->buf.size;
+	size_t newslots;
+	size_t tail;
+	int res;
+
+	if (nobj <= g->gapsize) {
+		return SCV_OK;
+	}
+
+	if (nobj - g->gapsize >= (size_t) -1 / g->buf.objsize - oldslots) {
+		return SCV_ERANGE;
+	}
+
+	res = scv_resize(&g->buf, oldslots + (nobj - g->gapsize));
+
+	if (res != SCV_OK) {
+		return res;
+	}
+
+	newslots = scv_capacity(&g->buf);
+
+	res = scv_resize(&g->buf, newslots);
+
+	assert(res == SCV_OK);
+
+	/* Move elements after the gap to the end of the new slots */
+	tail = oldslots - (g->gap + g->gapsize);
+
+	if (tail > 0) {
+		memmove(SCV_GAP_SLOT(g, newslots - tail),
+		        SCV_GAP_SLOT(g, g->gap + g->gapsize),
+		        tail * g->buf.objsize);
+	}
+
+	g->gapsize += newslots - oldslots;
+
+	return SCV_OK;
+}
+
+struct scv_gap *scv_gap_new(size_t objsize, size_t capacity)
+{
+	struct scv_gap *g;
+
+	g = (struct scv_gap *) malloc(sizeof *g);
+
+	if (g == NULL) {
+		return NULL;
+	}
+
+	if (scv_init(&g->buf, objsize) != SCV_OK) {
+		free(g);
+		return NULL;
+	}
+
+	g->gap = 0;
+	g->gapsize = 0;
+
+	if (capacity > 0 && (scv_reserve(&g->buf, capacity) != SCV_OK
+	                  || scv_resize(&g->buf, capacity) != SCV_OK)) {
+		scv_destroy(&g->buf);
+		free(g);
+		return NULL;
+	}
+
+	g->gapsize = g->buf.size;
+
+	return g;
+}
+
+void scv_gap_delete(struct scv_gap *g)
+{
+	if (g == NULL) {
+		return;
+	}
+
+	scv_destroy(&g->buf);
+
+	free(g);
+}
+
+void *scv_gap_at(struct scv_gap *g, size_t i)
+{
+	assert(g != NULL);
+
+	if (i >= scv_gap_size(g)) {
+		return NULL;
+	}
+
+	return SCV_GAP_SLOT(g, i < g->gap ? i : i + g->gapsize);
+}
+
+size_t scv_gap_size(const struct scv_gap *g)
+{
+	assert(g != NULL);
+
+	return g->buf.size - g->gapsize;
+}
+
+size_t scv_gap_objsize(const struct scv_gap *g)
+{
+	assert(g != NULL);
+
+	return g->buf.objsize;
+}
+
+size_t scv_gap_cursor(const struct scv_gap *g)
+{
+	assert(g != NULL);
+
+	return g->gap;
+}
+
+int scv_gap_move(struct scv_gap *g, size_t i)
+{
+	assert(g != NULL);
+
+	if (i > scv_gap_size(g)) {
+		return SCV_ERANGE;
+	}
+
+	if (g->gapsize > 0) {
+		if (i < g->gap) {
+			/* Move elements [i, gap) to after the gap */
+			memmove(SCV_GAP_SLOT(g, i + g->gapsize),
+			        SCV_GAP_SLOT(g, i),
+			        (g->gap - i) * g->buf.objsize);
+		}
+		else if (i > g->gap) {
+			/* Move elements [gap, i) to before the gap */
+			memmove(SCV_GAP_SLOT(g, g->gap),
+			        SCV_GAP_SLOT(g, g->gap + g->gapsize),
+			        (i - g->gap) * g->buf.objsize);
+		}
+	}
+
+	g->gap = i;
+
+	return SCV_OK;
+}
+
+int scv_gap_replace(struct scv_gap *g, size_t i, size_t j, const void *data, size_t nobj)
+{
+	int res;
+
+	assert(g != NULL);
+
+	if (i > j || j > scv_gap_size(g)) {
+		return SCV_ERANGE;
+	}
+
+	res = scv_gap_move(g, j);
+
+	assert(res == SCV_OK);
+
+	/* Elements [i, j) are now right before the gap, so erase by
+	 * extending the gap */
+	g->gap = i;
+	g->gapsize += j - i;
+
+	res = scv_gap_i_grow(g, nobj);
+
+	if (res != SCV_OK) {
+		/* Leave the erased elements in place */
+		g->gap = j;
+		g->gapsize -= j - i;
+		return res;
+	}
+
+	if (data != NULL && nobj > 0) {
+		memcpy(SCV_GAP_SLOT(g, g->gap), data, nobj * g->buf.objsize);
+	}
+
+	g->gap += nobj;
+	g->gapsize -= nobj;
+
+	return SCV_OK;
+}
+
+int scv_gap_insert(struct scv_gap *g, size_t i, const void *data, size_t nobj)
+{
+	return scv_gap_replace(g, i, i, data, nobj);
+}
+
+int scv_gap_erase(struct scv_gap *g, size_t i, size_t j)
+{
+	return scv_gap_replace(g, i, j, NULL, 0);
+}
+
+void *scv_gap_data(struct scv_gap *g)
+{
+	assert(g != NULL);
+
+	if (scv_gap_size(g) == 0) {
+		return NULL;
+	}
+
+	scv_gap_move(g, scv_gap_size(g));
+
+	return scv_data(&g->buf);
+}
@@ -0,0 +1,171 @@
+/*
+ * scv - Simple C Vector
+ *
+ * scv_gap.h
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCV_GAP_H_INCLUDED
+#define SCV_GAP_H_INCLUDED
+
+#include "scv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Structure representing a `scv_gap` buffer.
+ *
+ * A `scv_gap` stores its elements in a `scv_vector` with a gap of unused
+ * space at the position of the last edit. Edits near that position only
+ * move the elements between the old and new position of the gap, instead
+ * of all elements after the edit.
+ *
+ * @see scv_gap_new
+ */
+struct scv_gap {
+	struct scv_vector buf; /**< Storage for elements and gap. */
+	size_t gap;            /**< Index of start of gap. */
+	size_t gapsize;        /**< Size of gap in number of elements. */
+};
+
+/**
+ * Create a new `scv_gap`.
+ *
+ * @param objsize size of each element in bytes
+ * @param capacity initial capacity in number of elements
+ * @return pointer to `scv_gap`, `NULL` on error
+ */
+struct scv_gap *scv_gap_new(size_t objsize, size_t capacity);
+
+/**
+ * Destroy `g`, freeing the associated memory.
+ *
+ * @param g pointer to `scv_gap`
+ */
+void scv_gap_delete(struct scv_gap *g);
+
+/**
+ * Return a pointer to element number `i` of `g`.
+ *
+ * @param g pointer to `scv_gap`
+ * @param i index
+ * @return pointer to element `i`, `NULL` on error
+ */
+void *scv_gap_at(struct scv_gap *g, size_t i);
+
+/**
+ * Return the size of `g`.
+ *
+ * @param g pointer to `scv_gap`
+ * @return size in number of elements
+ */
+size_t scv_gap_size(const struct scv_gap *g);
+
+/**
+ * Return the size of each element in `g`.
+ *
+ * @param g pointer to `scv_gap`
+ * @return size of each element in bytes
+ */
+size_t scv_gap_objsize(const struct scv_gap *g);
+
+/**
+ * Return the position of the gap in `g`.
+ *
+ * Edits at this position do not need to move any elements.
+ *
+ * @param g pointer to `scv_gap`
+ * @return index of first element after the gap
+ */
+size_t scv_gap_cursor(const struct scv_gap *g);
+
+/**
+ * Move the gap in `g` to before element number `i`.
+ *
+ * This moves the elements between the current position of the gap and `i`.
+ *
+ * `i` can be `scv_gap_size(g)`, in which case the gap is moved to the end.
+ *
+ * @param g pointer to `scv_gap`
+ * @param i index
+ * @return zero on success, error code on error
+ */
+int scv_gap_move(struct scv_gap *g, size_t i);
+
+/**
+ * Replace elements from `i` up to, but not including, `j` in `g`, with
+ * `nobj` elements from `data`.
+ *
+ * The gap is moved to `j`, and ends up after the inserted elements.
+ *
+ * If `data` is `NULL`, any inserted elements are not initialized.
+ *
+ * `data` must not point inside `g`.
+ *
+ * @param g pointer to `scv_gap`
+ * @param i start index
+ * @param j end index
+ * @param data pointer to data to copy into new elements
+ * @param nobj number of elements to insert
+ * @return zero on success, error code on error
+ */
+int scv_gap_replace(struct scv_gap *g, size_t i, size_t j, const void *data, size_t nobj);
+
+/**
+ * Insert `nobj` elements from `data` before element number `i` of `g`.
+ *
+ * @see scv_gap_replace
+ *
+ * @param g pointer to `scv_gap`
+ * @param i index
+ * @param data pointer to data to copy into new elements
+ * @param nobj number of elements to insert
+ * @return zero on success, error code on error
+ */
+int scv_gap_insert(struct scv_gap *g, size_t i, const void *data, size_t nobj);
+
+/**
+ * Remove elements from `i` up to, but not including, `j` from `g`.
+ *
+ * @see scv_gap_replace
+ *
+ * @param g pointer to `scv_gap`
+ * @param i start index
+ * @param j end index
+ * @return zero on success, error code on error
+ */
+int scv_gap_erase(struct scv_gap *g, size_t i, size_t j);
+
+/**
+ * Return a pointer to the elements of `g` in contiguous memory.
+ *
+ * This moves the gap to the end. The pointer is valid until `g` is
+ * modified.
+ *
+ * @param g pointer to `scv_gap`
+ * @return pointer to elements, `NULL` if empty
+ */
+void *scv_gap_data(struct scv_gap *g);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* SCV_GAP_H_INCLUDED */
@@ -0,0 +1,853 @@
+/*
+ * scv - Simple C Vector
+ *
+ * scv_rope.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "scv_rope.h"
+
+/**
+ * Maximum number of children of an inner node.
+ */
+#define SCV_ROPE_FANOUT (32)
+
+/**
+ * Target size of leaf chunks in bytes.
+ */
+#define SCV_ROPE_LEAF_BYTES (4096u)
+
+/**
+ * Maximum number of inner levels.
+ *
+ * Inner nodes other than the root are kept at least half full, by merging
+ * or rebalancing them on erase, so this is far more than can be reached
+ * with the memory of any machine. Splits that would exceed it fail.
+ */
+#define SCV_ROPE_MAX_DEPTH (40)
+
+/**
+ * Union of types with strict alignment requirements.
+ */
+union scv_rope_i_max_align {
+	long double ld;
+	double d;
+	long l;
+	void *p;
+	void (*fp)(void);
+};
+
+struct scv_rope_i_align_check {
+	char c;
+	union scv_rope_i_max_align u;
+};
+
+/**
+ * Alignment suitable for any object type.
+ */
+#define SCV_ROPE_MAX_ALIGN (offsetof(struct scv_rope_i_align_check, u))
+
+/**
+ * Common header of tree nodes.
+ */
+struct scv_rope_node {
+	int leaf; /**< Non-zero if node is a leaf. */
+};
+
+/**
+ * Inner node of tree.
+ *
+ * `counts[k]` is the number of elements below `child[k]`.
+ */
+struct scv_rope_inner {
+	struct scv_rope_node node;
+	size_t n;                                       /**< Number of children. */
+	size_t counts[SCV_ROPE_FANOUT];                 /**< Element counts. */
+	struct scv_rope_node *child[SCV_ROPE_FANOUT];   /**< Children. */
+};
+
+/**
+ * Leaf node of tree, holding a chunk of elements.
+ *
+ * The elements follow the structure, at offset `SCV_ROPE_LEAF_HDR`.
+ */
+struct scv_rope_leaf {
+	struct scv_rope_node node;
+	size_t n;                   /**< Number of elements. */
+	struct scv_rope_leaf *prev; /**< Previous leaf in order. */
+	struct scv_rope_leaf *next; /**< Next leaf in order. */
+};
+
+#define SCV_ROPE_LEAF_HDR \
+	((sizeof(struct scv_rope_leaf) + (SCV_ROPE_MAX_ALIGN - 1)) \
+	 & ~((size_t) SCV_ROPE_MAX_ALIGN - 1))
+
+#define SCV_ROPE_DATA(leaf) ((char *) (leaf) + SCV_ROPE_LEAF_HDR)
+
+struct scv_rope {
+	struct scv_rope_node *root; /**< Root of tree. */
+	size_t objsize;             /**< Size of each element in bytes. */
+	size_t size;                /**< Number of elements. */
+	size_t leafcap;             /**< Capacity of leaves in number of elements. */
+};
+
+/**
+ * Path from the root to a leaf.
+ *
+ * `idx[d]` is the index of the child taken in `node[d]`.
+ */
+struct scv_rope_path {
+	struct scv_rope_inner *node[SCV_ROPE_MAX_DEPTH];
+	size_t idx[SCV_ROPE_MAX_DEPTH];
+	size_t depth;
+};
+
+static struct scv_rope_leaf *scv_rope_i_new_leaf(const struct scv_rope *r)
+{
+	struct scv_rope_leaf *leaf;
+
+	leaf = (struct scv_rope_leaf *) malloc(SCV_ROPE_LEAF_HDR + r->leafcap * r->objsize);
+
+	if (leaf == NULL) {
+		return NULL;
+	}
+
+	leaf->node.leaf = 1;
+	leaf->n = 0;
+	leaf->prev = NULL;
+	leaf->next = NULL;
+
+	return leaf;
+}
+
+static void scv_rope_i_free_node(struct scv_rope_node *node)
+{
+	if (!node->leaf) {
+		struct scv_rope_inner *in = (struct scv_rope_inner *) node;
+		size_t k;
+
+		for (k = 0; k < in->n; ++k) {
+			scv_rope_i_free_node(in->child[k]);
+		}
+	}
+
+	free(node);
+}
+
+/**
+ * Find the leaf holding element number `i` of `r`.
+ *
+ * If `i` is on the boundary between two leaves, the later one is
+ * returned. If `i` is the size of `r`, the last leaf is returned.
+ *
+ * @param r pointer to `scv_rope`
+ * @param i index, at most `r->size`
+ * @param path pointer to where to store path to leaf
+ * @param offset pointer to where to store index of element in leaf
+ * @return pointer to leaf
+ */
+static struct scv_rope_leaf *scv_rope_i_locate(const struct scv_rope *r, size_t i,
+                                               struct scv_rope_path *path,
+                                               size_t *offset)
+{
+	struct scv_rope_node *node = r->root;
+	size_t depth = 0;
+
+	while (!node->leaf) {
+		struct scv_rope_inner *in = (struct scv_rope_inner *) node;
+		size_t k;
+
+		for (k = 0; k + 1 < in->n && i >= in->counts[k]; ++k) {
+			i -= in->counts[k];
+		}
+
+		assert(depth < SCV_ROPE_MAX_DEPTH);
+
+		path->node[depth] = in;
+		path->idx[depth] = k;
+		++depth;
+
+		node = in->child[k];
+	}
+
+	path->depth = depth;
+	*offset = i;
+
+	return (struct scv_rope_leaf *) node;
+}
+
+/**
+ * Add `delta` to the counts along `path`, wrapping to subtract.
+ */
+static void scv_rope_i_add_counts(struct scv_rope_path *path, size_t delta)
+{
+	size_t d;
+
+	for (d = 0; d < path->depth; ++d) {
+		path->node[d]->counts[path->idx[d]] += delta;
+	}
+}
+
+static size_t scv_rope_i_sum(const struct scv_rope_inner *in)
+{
+	size_t sum = 0;
+	size_t k;
+
+	for (k = 0; k < in->n; ++k) {
+		sum += in->counts[k];
+	}
+
+	return sum;
+}
+
+/**
+ * Insert `right` after the node at level `d` of `path`, splitting inner
+ * nodes as needed, using nodes from `spare`.
+ *
+ * @param r pointer to `scv_rope`
+ * @param path path to node being split
+ * @param d level of node being split, `path->depth` for the leaf
+ * @param left node being split
+ * @param cl number of elements below `left`
+ * @param right new node
+ * @param cr number of elements below `right`
+ * @param spare pointer to array of preallocated inner nodes
+ */
+static void scv_rope_i_insert_child(struct scv_rope *r, struct scv_rope_path *path,
+                                    size_t d,
+                                    struct scv_rope_node *left, size_t cl,
+                                    struct scv_rope_node *right, size_t cr,
+                                    struct scv_rope_inner **spare)
+{
+	struct scv_rope_inner *p;
+	struct scv_rope_inner *q;
+	size_t half = SCV_ROPE_FANOUT / 2;
+	size_t k;
+
+	if (d == 0) {
+		/* Splitting the root, so add a new root */
+		p = *spare++;
+
+		p->node.leaf = 0;
+		p->n = 2;
+		p->counts[0] = cl;
+		p->child[0] = left;
+		p->counts[1] = cr;
+		p->child[1] = right;
+
+		r->root = &p->node;
+
+		return;
+	}
+
+	p = path->node[d - 1];
+	k = path->idx[d - 1];
+
+	p->counts[k] = cl;
+
+	if (p->n == SCV_ROPE_FANOUT) {
+		/* Move upper half of children to new node */
+		q = *spare++;
+
+		q->node.leaf = 0;
+		q->n = SCV_ROPE_FANOUT - half;
+		memcpy(q->counts, p->counts + half, q->n * sizeof(size_t));
+		memcpy(q->child, p->child + half, q->n * sizeof(struct scv_rope_node *));
+		p->n = half;
+	}
+	else {
+		q = NULL;
+	}
+
+	if (q == NULL || k + 1 <= half) {
+		memmove(p->counts + k + 2, p->counts + k + 1, (p->n - (k + 1)) * sizeof(size_t));
+		memmove(p->child + k + 2, p->child + k + 1, (p->n - (k + 1)) * sizeof(struct scv_rope_node *));
+		p->counts[k + 1] = cr;
+		p->child[k + 1] = right;
+		p->n += 1;
+	}
+	else {
+		k -= half;
+
+		memmove(q->counts + k + 2, q->counts + k + 1, (q->n - (k + 1)) * sizeof(size_t));
+		memmove(q->child + k + 2, q->child + k + 1, (q->n - (k + 1)) * sizeof(struct scv_rope_node *));
+		q->counts[k + 1] = cr;
+		q->child[k + 1] = right;
+		q->n += 1;
+	}
+
+	if (q != NULL) {
+		scv_rope_i_insert_child(r, path, d - 1, &p->node, scv_rope_i_sum(p),
+		                        &q->node, scv_rope_i_sum(q), spare);
+	}
+}
+
+/**
+ * Split `leaf`, moving elements from `s` and up to a new leaf after it.
+ *
+ * @param r pointer to `scv_rope`
+ * @param path path to `leaf`
+ * @param leaf pointer to leaf
+ * @param s number of elements to keep in `leaf`
+ * @return zero on success, error code on error
+ */
+static int scv_rope_i_split_leaf(struct scv_rope *r, struct scv_rope_path *path,
+                                 struct scv_rope_leaf *leaf, size_t s)
+{
+	struct scv_rope_inner *spare[SCV_ROPE_MAX_DEPTH + 1];
+	struct scv_rope_leaf *q;
+	size_t nspare = 0;
+	size_t d;
+	size_t k;
+
+	/* Allocate all nodes needed up front, so failure leaves r unchanged */
+	for (d = path->depth; d > 0 && path->node[d - 1]->n == SCV_ROPE_FANOUT; --d) {
+		++nspare;
+	}
+
+	if (d == 0) {
+		++nspare;
+	}
+
+	if (nspare > SCV_ROPE_MAX_DEPTH - path->depth) {
+		return SCV_ERANGE;
+	}
+
+	for (k = 0; k < nspare; ++k) {
+		spare[k] = (struct scv_rope_inner *) malloc(sizeof(struct scv_rope_inner));
+
+		if (spare[k] == NULL) {
+			while (k > 0) {
+				free(spare[--k]);
+			}
+
+			return SCV_ENOMEM;
+		}
+	}
+
+	q = scv_rope_i_new_leaf(r);
+
+	if (q == NULL) {
+		for (k = 0; k < nspare; ++k) {
+			free(spare[k]);
+		}
+
+		return SCV_ENOMEM;
+	}
+
+	q->n = leaf->n - s;
+	memcpy(SCV_ROPE_DATA(q), SCV_ROPE_DATA(leaf) + s * r->objsize, q->n * r->objsize);
+	leaf->n = s;
+
+	q->prev = leaf;
+	q->next = leaf->next;
+	if (leaf->next != NULL) {
+		leaf->next->prev = q;
+	}
+	leaf->next = q;
+
+	scv_rope_i_insert_child(r, path, path->depth, &leaf->node, leaf->n,
+	                        &q->node, q->n, spare);
+
+	return SCV_OK;
+}
+
+static void scv_rope_i_remove_child(struct scv_rope *r, struct scv_rope_path *path, size_t d);
+
+/**
+ * Merge the inner node at level `e` of `path`, which must not be the root,
+ * with an adjacent node with the same parent if the children of both fit
+ * in one node, or move children between them so both are at least half
+ * full.
+ */
+static void scv_rope_i_fix_inner(struct scv_rope *r, struct scv_rope_path *path, size_t e)
+{
+	struct scv_rope_inner *g;
+	struct scv_rope_inner *a;
+	struct scv_rope_inner *b;
+	size_t k;
+	size_t m;
+
+	assert(e > 0);
+
+	g = path->node[e - 1];
+	k = path->idx[e - 1];
+
+	/* Balance b with a, where a is at index k */
+	if (k + 1 < g->n) {
+		a = path->node[e];
+		b = (struct scv_rope_inner *) g->child[k + 1];
+	}
+	else if (k > 0) {
+		k -= 1;
+		a = (struct scv_rope_inner *) g->child[k];
+		b = path->node[e];
+	}
+	else {
+		return;
+	}
+
+	if (a->n + b->n <= SCV_ROPE_FANOUT) {
+		memcpy(a->counts + a->n, b->counts, b->n * sizeof(size_t));
+		memcpy(a->child + a->n, b->child, b->n * sizeof(struct scv_rope_node *));
+		a->n += b->n;
+		g->counts[k] += g->counts[k + 1];
+		b->n = 0;
+
+		free(b);
+
+		path->idx[e - 1] = k + 1;
+
+		scv_rope_i_remove_child(r, path, e);
+
+		return;
+	}
+
+	/* Split the children evenly, a->n + b->n > SCV_ROPE_FANOUT */
+	m = (a->n + b->n) / 2;
+
+	if (a->n < m) {
+		size_t t = m - a->n;
+
+		memcpy(a->counts + a->n, b->counts, t * sizeof(size_t));
+		memcpy(a->child + a->n, b->child, t * sizeof(struct scv_rope_node *));
+		memmove(b->counts, b->counts + t, (b->n - t) * sizeof(size_t));
+		memmove(b->child, b->child + t, (b->n - t) * sizeof(struct scv_rope_node *));
+		a->n += t;
+		b->n -= t;
+	}
+	else {
+		size_t t = a->n - m;
+
+		memmove(b->counts + t, b->counts, b->n * sizeof(size_t));
+		memmove(b->child + t, b->child, b->n * sizeof(struct scv_rope_node *));
+		memcpy(b->counts, a->counts + m, t * sizeof(size_t));
+		memcpy(b->child, a->child + m, t * sizeof(struct scv_rope_node *));
+		a->n -= t;
+		b->n += t;
+	}
+
+	g->counts[k] = scv_rope_i_sum(a);
+	g->counts[k + 1] = scv_rope_i_sum(b);
+}
+
+/**
+ * Remove the node at level `d` of `path` from its parent, removing any
+ * inner nodes left empty, merging or rebalancing inner nodes left less
+ * than half full, and shortening the tree while the root has a single
+ * child.
+ */
+static void scv_rope_i_remove_child(struct scv_rope *r, struct scv_rope_path *path, size_t d)
+{
+	struct scv_rope_inner *p;
+	size_t k;
+
+	assert(d > 0);
+
+	p = path->node[d - 1];
+	k = path->idx[d - 1];
+
+	memmove(p->counts + k, p->counts + k + 1, (p->n - (k + 1)) * sizeof(size_t));
+	memmove(p->child + k, p->child + k + 1, (p->n - (k + 1)) * sizeof(struct scv_rope_node *));
+	p->n -= 1;
+
+	if (p->n == 0) {
+		/* The root always has at least two children */
+		assert(d > 1);
+
+		free(p);
+
+		scv_rope_i_remove_child(r, path, d - 1);
+
+		return;
+	}
+
+	if (d > 1 && p->n < SCV_ROPE_FANOUT / 2) {
+		scv_rope_i_fix_inner(r, path, d - 1);
+	}
+
+	while (!r->root->leaf && ((struct scv_rope_inner *) r->root)->n == 1) {
+		struct scv_rope_inner *root = (struct scv_rope_inner *) r->root;
+
+		r->root = root->child[0];
+
+		free(root);
+	}
+}
+
+/**
+ * Remove `leaf`, which must be empty and not the root.
+ */
+static void scv_rope_i_remove_leaf(struct scv_rope *r, struct scv_rope_path *path,
+                                   struct scv_rope_leaf *leaf)
+{
+	assert(leaf->n == 0 && path->depth > 0);
+
+	if (leaf->prev != NULL) {
+		leaf->prev->next = leaf->next;
+	}
+	if (leaf->next != NULL) {
+		leaf->next->prev = leaf->prev;
+	}
+
+	free(leaf);
+
+	scv_rope_i_remove_child(r, path, path->depth);
+}
+
+/**
+ * Merge `leaf` with an adjacent leaf with the same parent, if the elements
+ * of both fit in one leaf.
+ */
+static void scv_rope_i_merge_leaf(struct scv_rope *r, struct scv_rope_path *path,
+                                  struct scv_rope_leaf *leaf)
+{
+	struct scv_rope_inner *p;
+	struct scv_rope_leaf *a;
+	struct scv_rope_leaf *b;
+	size_t k;
+
+	if (path->depth == 0) {
+		return;
+	}
+
+	p = path->node[path->depth - 1];
+	k = path->idx[path->depth - 1];
+
+	/* Merge b into a, where a is at index k */
+	if (k + 1 < p->n) {
+		a = leaf;
+		b = (struct scv_rope_leaf *) p->child[k + 1];
+	}
+	else if (k > 0) {
+		k -= 1;
+		a = (struct scv_rope_leaf *) p->child[k];
+		b = leaf;
+	}
+	else {
+		return;
+	}
+
+	if (a->n + b->n > r->leafcap) {
+		return;
+	}
+
+	memcpy(SCV_ROPE_DATA(a) + a->n * r->objsize, SCV_ROPE_DATA(b), b->n * r->objsize);
+	a->n += b->n;
+	p->counts[k] += b->n;
+	p->counts[k + 1] = 0;
+	b->n = 0;
+
+	path->idx[path->depth - 1] = k + 1;
+
+	scv_rope_i_remove_leaf(r, path, b);
+}
+
+/**
+ * Insert up to `nobj` elements from `data` before element number `i`
+ * of `r`, in a single leaf.
+ *
+ * @return number of elements inserted, zero on error
+ */
+static size_t scv_rope_i_insert_some(struct scv_rope *r, size_t i, const char *data,
+                                     size_t nobj, int *res)
+{
+	struct scv_rope_path path;
+	struct scv_rope_leaf *leaf;
+	size_t offset;
+	size_t n;
+
+	leaf = scv_rope_i_locate(r, i, &path, &offset);
+
+	if (leaf->n == r->leafcap) {
+		/* Start a new leaf when appending to this one, otherwise halve it */
+		size_t s = offset == leaf->n ? leaf->n : leaf->n / 2;
+
+		*res = scv_rope_i_split_leaf(r, &path, leaf, s);
+
+		if (*res != SCV_OK) {
+			return 0;
+		}
+
+		leaf = scv_rope_i_locate(r, i, &path, &offset);
+	}
+
+	n = r->leafcap - leaf->n < nobj ? r->leafcap - leaf->n : nobj;
+
+	assert(n > 0);
+
+	memmove(SCV_ROPE_DATA(leaf) + (offset + n) * r->objsize,
+	        SCV_ROPE_DATA(leaf) + offset * r->objsize,
+	        (leaf->n - offset) * r->objsize);
+
+	if (data != NULL) {
+		memcpy(SCV_ROPE_DATA(leaf) + offset * r->objsize, data, n * r->objsize);
+	}
+
+	leaf->n += n;
+	scv_rope_i_add_counts(&path, n);
+	r->size += n;
+
+	return n;
+}
+
+struct scv_rope *scv_rope_new(size_t objsize)
+{
+	struct scv_rope *r;
+	struct scv_rope_leaf *leaf;
+
+	if (objsize == 0 || objsize >= ((size_t) -1 - SCV_ROPE_LEAF_HDR) / 4) {
+		return NULL;
+	}
+
+	r = (struct scv_rope *) malloc(sizeof *r);
+
+	if (r == NULL) {
+		return NULL;
+	}
+
+	r->objsize = objsize;
+	r->size = 0;
+
+	/* Leaves hold at least 4 elements, so splits make progress */
+	r->leafcap = SCV_ROPE_LEAF_BYTES / objsize;
+
+	if (r->leafcap < 4) {
+		r->leafcap = 4;
+	}
+
+	leaf = scv_rope_i_new_leaf(r);
+
+	if (leaf == NULL) {
+		free(r);
+		return NULL;
+	}
+
+	r->root = &leaf->node;
+
+	return r;
+}
+
+void scv_rope_delete(struct scv_rope *r)
+{
+	if (r == NULL) {
+		return;
+	}
+
+	scv_rope_i_free_node(r->root);
+
+	free(r);
+}
+
+void *scv_rope_at(struct scv_rope *r, size_t i)
+{
+	struct scv_rope_path path;
+	struct scv_rope_leaf *leaf;
+	size_t offset;
+
+	assert(r != NULL);
+
+	if (i >= r->size) {
+		return NULL;
+	}
+
+	leaf = scv_rope_i_locate(r, i, &path, &offset);
+
+	return SCV_ROPE_DATA(leaf) + offset * r->objsize;
+}
+
+size_t scv_rope_size(const struct scv_rope *r)
+{
+	assert(r != NULL);
+
+	return r->size;
+}
+
+size_t scv_rope_objsize(const struct scv_rope *r)
+{
+	assert(r != NULL);
+
+	return r->objsize;
+}
+
+int scv_rope_replace(struct scv_rope *r, size_t i, size_t j, const void *data, size_t nobj)
+{
+	const char *p = (const char *) data;
+	int res;
+
+	assert(r != NULL);
+
+	if (i > j || j > r->size) {
+		return SCV_ERANGE;
+	}
+
+	if (nobj >= (size_t) -1 / r->objsize - (r->size - (j - i))) {
+		return SCV_ERANGE;
+	}
+
+	res = scv_rope_erase(r, i, j);
+
+	if (res != SCV_OK) {
+		return res;
+	}
+
+	while (nobj > 0) {
+		size_t n = scv_rope_i_insert_some(r, i, p, nobj, &res);
+
+		if (n == 0) {
+			return res;
+		}
+
+		if (p != NULL) {
+			p += n * r->objsize;
+		}
+
+		i += n;
+		nobj -= n;
+	}
+
+	return SCV_OK;
+}
+
+int scv_rope_insert(struct scv_rope *r, size_t i, const void *data, size_t nobj)
+{
+	return scv_rope_replace(r, i, i, data, nobj);
+}
+
+int scv_rope_erase(struct scv_rope *r, size_t i, size_t j)
+{
+	assert(r != NULL);
+
+	if (i > j || j > r->size) {
+		return SCV_ERANGE;
+	}
+
+	while (i < j) {
+		struct scv_rope_path path;
+		struct scv_rope_leaf *leaf;
+		size_t offset;
+		size_t n;
+
+		leaf = scv_rope_i_locate(r, i, &path, &offset);
+
+		n = leaf->n - offset < j - i ? leaf->n - offset : j - i;
+
+		memmove(SCV_ROPE_DATA(leaf) + offset * r->objsize,
+		        SCV_ROPE_DATA(leaf) + (offset + n) * r->objsize,
+		        (leaf->n - (offset + n)) * r->objsize);
+
+		leaf->n -= n;
+		scv_rope_i_add_counts(&path, (size_t) 0 - n);
+		r->size -= n;
+		j -= n;
+
+		if (leaf->n == 0 && path.depth > 0) {
+			scv_rope_i_remove_leaf(r, &path, leaf);
+		}
+		else if (leaf->n < r->leafcap / 4) {
+			scv_rope_i_merge_leaf(r, &path, leaf);
+		}
+	}
+
+	return SCV_OK;
+}
+
+int scv_rope_flatten(struct scv_rope *r, struct scv_vector *v)
+{
+	struct scv_rope_cursor c;
+	const char *p;
+	char *dst;
+	size_t n;
+	int res;
+
+	assert(r != NULL);
+	assert(v != NULL);
+
+	if (scv_objsize(v) != r->objsize) {
+		return SCV_EINVAL;
+	}
+
+	res = scv_assign(v, NULL, r->size);
+
+	if (res != SCV_OK) {
+		return res;
+	}
+
+	dst = (char *) scv_data(v);
+
+	scv_rope_seek(r, &c, 0);
+
+	while ((p = (const char *) scv_rope_next(r, &c, &n)) != NULL) {
+		memcpy(dst, p, n * r->objsize);
+		dst += n * r->objsize;
+	}
+
+	return SCV_OK;
+}
+
+int scv_rope_seek(struct scv_rope *r, struct scv_rope_cursor *c, size_t i)
+{
+	struct scv_rope_path path;
+
+	assert(r != NULL);
+	assert(c != NULL);
+
+	if (i > r->size) {
+		return SCV_ERANGE;
+	}
+
+	c->leaf = scv_rope_i_locate(r, i, &path, &c->offset);
+
+	return SCV_OK;
+}
+
+void *scv_rope_next(struct scv_rope *r, struct scv_rope_cursor *c, size_t *nobj)
+{
+	struct scv_rope_leaf *leaf;
+	char *p;
+
+	assert(r != NULL);
+	assert(c != NULL);
+	assert(nobj != NULL);
+
+	leaf = (struct scv_rope_leaf *) c->leaf;
+
+	while (leaf != NULL && c->offset >= leaf->n) {
+		leaf = leaf->next;
+		c->offset = 0;
+	}
+
+	if (leaf == NULL) {
+		c->leaf = NULL;
+		*nobj = 0;
+		return NULL;
+	}
+
+	p = SCV_ROPE_DATA(leaf) + c->offset * r->objsize;
+	*nobj = leaf->n - c->offset;
+
+	c->leaf = leaf->next;
+	c->offset = 0;
+
+	return p;
+}
@@ -0,0 +1,195 @@
+/*
+ * scv - Simple C Vector
+ *
+ * scv_rope.h
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCV_ROPE_H_INCLUDED
+#define SCV_ROPE_H_INCLUDED
+
+#include "scv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Opaque structure representing a `scv_rope` sequence.
+ *
+ * A `scv_rope` stores its elements in chunks of a few kilobytes, which are
+ * the leaves of a B-tree indexed by element count. Accessing, inserting,
+ * and erasing elements anywhere takes time logarithmic in the size, plus
+ * the size of a chunk, instead of moving all following elements.
+ *
+ * @see scv_rope_new
+ */
+struct scv_rope;
+
+/**
+ * Structure representing a position in a `scv_rope`.
+ *
+ * A cursor is invalidated by any modification of the `scv_rope`.
+ *
+ * @see scv_rope_seek
+ */
+struct scv_rope_cursor {
+	void *leaf;    /**< Current chunk, `NULL` at end. */
+	size_t offset; /**< Index of next element in chunk. */
+};
+
+/**
+ * Create a new `scv_rope`.
+ *
+ * @param objsize size of each element in bytes
+ * @return pointer to `scv_rope`, `NULL` on error
+ */
+struct scv_rope *scv_rope_new(size_t objsize);
+
+/**
+ * Destroy `r`, freeing the associated memory.
+ *
+ * @param r pointer to `scv_rope`
+ */
+void scv_rope_delete(struct scv_rope *r);
+
+/**
+ * Return a pointer to element number `i` of `r`.
+ *
+ * The pointer is valid until `r` is modified.
+ *
+ * @param r pointer to `scv_rope`
+ * @param i index
+ * @return pointer to element `i`, `NULL` on error
+ */
+void *scv_rope_at(struct scv_rope *r, size_t i);
+
+/**
+ * Return the size of `r`.
+ *
+ * @param r pointer to `scv_rope`
+ * @return size in number of elements
+ */
+size_t scv_rope_size(const struct scv_rope *r);
+
+/**
+ * Return the size of each element in `r`.
+ *
+ * @param r pointer to `scv_rope`
+ * @return size of each element in bytes
+ */
+size_t scv_rope_objsize(const struct scv_rope *r);
+
+/**
+ * Replace elements from `i` up to, but not including, `j` in `r`, with
+ * `nobj` elements from `data`.
+ *
+ * If `data` is `NULL`, any inserted elements are not initialized.
+ *
+ * `data` must not point inside `r`.
+ *
+ * If memory runs out while inserting, the elements from `i` to `j` have
+ * been removed, and only some of the new elements may have been inserted.
+ *
+ * @param r pointer to `scv_rope`
+ * @param i start index
+ * @param j end index
+ * @param data pointer to data to copy into new elements
+ * @param nobj number of elements to insert
+ * @return zero on success, error code on error
+ */
+int scv_rope_replace(struct scv_rope *r, size_t i, size_t j, const void *data, size_t nobj);
+
+/**
+ * Insert `nobj` elements from `data` before element number `i` of `r`.
+ *
+ * `i` can be `scv_rope_size(r)`, in which case the elements are appended.
+ *
+ * @see scv_rope_replace
+ *
+ * @param r pointer to `scv_rope`
+ * @param i index
+ * @param data pointer to data to copy into new elements
+ * @param nobj number of elements to insert
+ * @return zero on success, error code on error
+ */
+int scv_rope_insert(struct scv_rope *r, size_t i, const void *data, size_t nobj);
+
+/**
+ * Remove elements from `i` up to, but not including, `j` from `r`.
+ *
+ * @param r pointer to `scv_rope`
+ * @param i start index
+ * @param j end index
+ * @return zero on success, error code on error
+ */
+int scv_rope_erase(struct scv_rope *r, size_t i, size_t j);
+
+/**
+ * Replace the contents of `v` with the elements of `r`.
+ *
+ * @param r pointer to `scv_rope`
+ * @param v pointer to `scv_vector` with the same `objsize` as `r`
+ * @return zero on success, error code on error
+ */
+int scv_rope_flatten(struct scv_rope *r, struct scv_vector *v);
+
+/**
+ * Set `c` to the position of element number `i` of `r`.
+ *
+ * `i` can be `scv_rope_size(r)`, in which case `c` is at the end.
+ *
+ * @param r pointer to `scv_rope`
+ * @param c pointer to cursor
+ * @param i index
+ * @return zero on success, error code on error
+ */
+int scv_rope_seek(struct scv_rope *r, struct scv_rope_cursor *c, size_t i);
+
+/**
+ * Return a pointer to the contiguous elements of `r` from `c` to the end
+ * of the chunk, and advance `c` past them.
+ *
+ * This allows iterating over elements at close to the speed of an array:
+ *
+ * ~~~
+ *     struct scv_rope_cursor c;
+ *     size_t i, n;
+ *     int *p;
+ *
+ *     scv_rope_seek(r, &c, 0);
+ *
+ *     while ((p = scv_rope_next(r, &c, &n)) != NULL) {
+ *         for (i = 0; i < n; ++i) {
+ *             // use p[i]
+ *         }
+ *     }
+ * ~~~
+ *
+ * @param r pointer to `scv_rope`
+ * @param c pointer to cursor
+ * @param nobj pointer to where to store number of elements
+ * @return pointer to elements, `NULL` at end
+ */
+void *scv_rope_next(struct scv_rope *r, struct scv_rope_cursor *c, size_t *nobj);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* SCV_ROPE_H_INCLUDED */
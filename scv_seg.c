@@ -0,0 +1,344 @@
+/*
+ * scv - Simple C Vector
+ *
+ * scv_seg.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "scv_seg.h"
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+/**
+ * Default minimum size of first segment in bytes.
+ */
+#define SCV_SEG_MIN_ALLOC (64u)
+
+/*
+ * Segment `k` holds `base << k` elements, starting at element number
+ * `base * (2^k - 1)`. The segments array holds a `char *` for each
+ * allocated segment.
+ *
+ * The segments array never uses incremental growth, so its data pointer
+ * is read directly.
+ */
+#define SCV_SEG_PTR(s, k) (((char **) (s)->segments.data)[k])
+
+/**
+ * Return floor(log2(`j`)), `j` must not be zero.
+ */
+static size_t scv_seg_i_log2(size_t j)
+{
+#if defined(__GNUC__) && defined(__SIZEOF_SIZE_T__) && defined(__SIZEOF_LONG__) \
+ && __SIZEOF_SIZE_T__ == __SIZEOF_LONG__
+	assert(j != 0);
+
+	return sizeof(size_t) * CHAR_BIT - 1 - (size_t) __builtin_clzl(j);
+#elif defined(_MSC_VER) && defined(_WIN64)
+	unsigned long k;
+
+	assert(j != 0);
+
+	_BitScanReverse64(&k, j);
+
+	return k;
+#elif defined(_MSC_VER)
+	unsigned long k;
+
+	assert(j != 0);
+
+	_BitScanReverse(&k, j);
+
+	return k;
+#else
+	size_t k = 0;
+	size_t shift;
+
+	assert(j != 0);
+
+	/* Binary search for the highest set bit */
+	for (shift = sizeof(size_t) * CHAR_BIT / 2; shift > 0; shift /= 2) {
+		if (j >> shift) {
+			j >>= shift;
+			k += shift;
+		}
+	}
+
+	return k;
+#endif
+}
+
+/**
+ * Return the index of the segment holding element number `i` of `s`, and
+ * store the index of the element within that segment in `offset`.
+ *
+ * Since `base` is a power of two, floor(log2(i / base + 1)) is
+ * floor(log2(i + base)) - log2(base).
+ */
+static size_t scv_seg_i_locate(const struct scv_seg *s, size_t i, size_t *offset)
+{
+	size_t k = scv_seg_i_log2(i + s->base) - s->shift;
+
+	*offset = i + s->base - (s->base << k);
+
+	return k;
+}
+
+/**
+ * Return the number of elements the allocated segments of `s` can hold.
+ */
+static size_t scv_seg_i_capacity(const struct scv_seg *s)
+{
+	return s->base * (((size_t) 1 << scv_size(&s->segments)) - 1);
+}
+
+/**
+ * Allocate the next segment of `s`.
+ *
+ * @param s pointer to `scv_seg`
+ * @return zero on success, error code on error
+ */
+static int scv_seg_i_add_segment(struct scv_seg *s)
+{
+	size_t k = scv_size(&s->segments);
+	size_t capacity = scv_seg_i_capacity(s);
+	size_t nobj;
+	char *p;
+	int res;
+
+	if (k + 1 >= sizeof(size_t) * CHAR_BIT) {
+		return SCV_ERANGE;
+	}
+
+	nobj = s->base << k;
+
+	if ((nobj >> k) != s->base || nobj >= (size_t) -1 / s->objsize - capacity) {
+		return SCV_ERANGE;
+	}
+
+	/* Make room in the index first, so the segment cannot leak */
+	res = scv_reserve(&s->segments, k + 1);
+
+	if (res != SCV_OK) {
+		return res;
+	}
+
+	p = (char *) malloc(nobj * s->objsize);
+
+	if (p == NULL) {
+		return SCV_ENOMEM;
+	}
+
+	res = scv_push_back(&s->segments, &p);
+
+	assert(res == SCV_OK);
+
+	return res;
+}
+
+struct scv_seg *scv_seg_new(size_t objsize, size_t base)
+{
+	struct scv_seg *s;
+	size_t pow2;
+
+	if (objsize == 0 || (size_t) -1 / objsize <= 1) {
+		return NULL;
+	}
+
+	if (base == 0) {
+		base = (SCV_SEG_MIN_ALLOC + (objsize - 1)) / objsize;
+	}
+
+	/* Round base up to a power of two */
+	for (pow2 = 1; pow2 < base; pow2 <<= 1) {
+		if (pow2 > ((size_t) -1 >> 1) / objsize) {
+			return NULL;
+		}
+	}
+
+	s = (struct scv_seg *) malloc(sizeof *s);
+
+	if (s == NULL) {
+		return NULL;
+	}
+
+	if (scv_init(&s->segments, sizeof(char *)) != SCV_OK) {
+		free(s);
+		return NULL;
+	}
+
+	s->objsize = objsize;
+	s->size = 0;
+	s->base = pow2;
+	s->shift = scv_seg_i_log2(pow2);
+
+	return s;
+}
+
+void scv_seg_delete(struct scv_seg *s)
+{
+	size_t k;
+
+	if (s == NULL) {
+		return;
+	}
+
+	for (k = 0; k < scv_size(&s->segments); ++k) {
+		free(SCV_SEG_PTR(s, k));
+	}
+
+	scv_destroy(&s->segments);
+
+	free(s);
+}
+
+void *scv_seg_at(struct scv_seg *s, size_t i)
+{
+	size_t offset;
+	size_t k;
+
+	assert(s != NULL);
+
+	if (i >= s->size) {
+		return NULL;
+	}
+
+	k = scv_seg_i_locate(s, i, &offset);
+
+	return SCV_SEG_PTR(s, k) + offset * s->objsize;
+}
+
+size_t scv_seg_size(const struct scv_seg *s)
+{
+	assert(s != NULL);
+
+	return s->size;
+}
+
+size_t scv_seg_objsize(const struct scv_seg *s)
+{
+	assert(s != NULL);
+
+	return s->objsize;
+}
+
+size_t scv_seg_capacity(const struct scv_seg *s)
+{
+	assert(s != NULL);
+
+	return scv_seg_i_capacity(s);
+}
+
+int scv_seg_reserve(struct scv_seg *s, size_t capacity)
+{
+	assert(s != NULL);
+
+	if (capacity >= (size_t) -1 / s->objsize) {
+		return SCV_ERANGE;
+	}
+
+	while (scv_seg_i_capacity(s) < capacity) {
+		int res = scv_seg_i_add_segment(s);
+
+		if (res != SCV_OK) {
+			return res;
+		}
+	}
+
+	return SCV_OK;
+}
+
+int scv_seg_push_back(struct scv_seg *s, const void *data)
+{
+	size_t offset;
+	size_t k;
+
+	assert(s != NULL);
+
+	if (s->size == scv_seg_i_capacity(s)) {
+		int res = scv_seg_i_add_segment(s);
+
+		if (res != SCV_OK) {
+			return res;
+		}
+	}
+
+	if (data != NULL) {
+		k = scv_seg_i_locate(s, s->size, &offset);
+
+		memcpy(SCV_SEG_PTR(s, k) + offset * s->objsize, data, s->objsize);
+	}
+
+	s->size += 1;
+
+	return SCV_OK;
+}
+
+int scv_seg_pop_back(struct scv_seg *s)
+{
+	assert(s != NULL);
+
+	if (s->size == 0) {
+		return SCV_ERANGE;
+	}
+
+	s->size -= 1;
+
+	return SCV_OK;
+}
+
+int scv_seg_clear(struct scv_seg *s)
+{
+	assert(s != NULL);
+
+	s->size = 0;
+
+	return SCV_OK;
+}
+
+void *scv_seg_segment(struct scv_seg *s, size_t k, size_t *nobj)
+{
+	size_t start;
+
+	assert(s != NULL);
+	assert(nobj != NULL);
+
+	*nobj = 0;
+
+	if (k >= scv_size(&s->segments)) {
+		return NULL;
+	}
+
+	start = s->base * (((size_t) 1 << k) - 1);
+
+	if (start >= s->size) {
+		return NULL;
+	}
+
+	*nobj = s->size - start < s->base << k ? s->size - start : s->base << k;
+
+	return SCV_SEG_PTR(s, k);
+}
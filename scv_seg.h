@@ -0,0 +1,167 @@
+/*
+ * scv - Simple C Vector
+ *
+ * scv_seg.h
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCV_SEG_H_INCLUDED
+#define SCV_SEG_H_INCLUDED
+
+#include "scv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Structure representing a `scv_seg` segmented vector.
+ *
+ * A `scv_seg` stores its elements in segments, where each segment is
+ * twice the size of the previous one. Growing allocates a new segment,
+ * and never moves existing elements, so pointers to elements stay valid
+ * until the elements are removed.
+ *
+ * @see scv_seg_new
+ */
+struct scv_seg {
+	struct scv_vector segments; /**< Pointers to segments. */
+	size_t objsize;             /**< Size of each element in bytes. */
+	size_t size;                /**< Used size in number of elements. */
+	size_t base;                /**< Capacity of first segment in number of elements. */
+	size_t shift;               /**< Base 2 logarithm of `base`. */
+};
+
+/**
+ * Create a new `scv_seg`.
+ *
+ * No memory is allocated for elements until the first is added.
+ *
+ * @param objsize size of each element in bytes
+ * @param base capacity of first segment in number of elements, rounded up
+ *        to a power of two, zero for default
+ * @return pointer to `scv_seg`, `NULL` on error
+ */
+struct scv_seg *scv_seg_new(size_t objsize, size_t base);
+
+/**
+ * Destroy `s`, freeing the associated memory.
+ *
+ * @param s pointer to `scv_seg`
+ */
+void scv_seg_delete(struct scv_seg *s);
+
+/**
+ * Return a pointer to element number `i` of `s`.
+ *
+ * @param s pointer to `scv_seg`
+ * @param i index
+ * @return pointer to element `i`, `NULL` on error
+ */
+void *scv_seg_at(struct scv_seg *s, size_t i);
+
+/**
+ * Return the size of `s`.
+ *
+ * @param s pointer to `scv_seg`
+ * @return size in number of elements
+ */
+size_t scv_seg_size(const struct scv_seg *s);
+
+/**
+ * Return the size of each element in `s`.
+ *
+ * @param s pointer to `scv_seg`
+ * @return size of each element in bytes
+ */
+size_t scv_seg_objsize(const struct scv_seg *s);
+
+/**
+ * Return the capacity of `s`.
+ *
+ * @param s pointer to `scv_seg`
+ * @return capacity in number of elements
+ */
+size_t scv_seg_capacity(const struct scv_seg *s);
+
+/**
+ * Reserve space for `capacity` elements in `s`.
+ *
+ * @param s pointer to `scv_seg`
+ * @param capacity requested capacity
+ * @return zero on success, error code on error
+ */
+int scv_seg_reserve(struct scv_seg *s, size_t capacity);
+
+/**
+ * Insert a single element from `data` at the end of `s`.
+ *
+ * If `data` is `NULL`, the inserted element is not initialized.
+ *
+ * @param s pointer to `scv_seg`
+ * @param data pointer to data to copy into new element
+ * @return zero on success, error code on error
+ */
+int scv_seg_push_back(struct scv_seg *s, const void *data);
+
+/**
+ * Remove the last element of `s`.
+ *
+ * @param s pointer to `scv_seg`
+ * @return zero on success, error code on error
+ */
+int scv_seg_pop_back(struct scv_seg *s);
+
+/**
+ * Remove all elements from `s`.
+ *
+ * The segments are kept for reuse.
+ *
+ * @param s pointer to `scv_seg`
+ * @return zero on success, error code on error
+ */
+int scv_seg_clear(struct scv_seg *s);
+
+/**
+ * Return a pointer to the elements in segment number `k` of `s`.
+ *
+ * The elements in each segment are contiguous, so this can be used to
+ * process all elements of `s` a segment at a time:
+ *
+ * ~~~
+ *     size_t k, n;
+ *     int *p;
+ *
+ *     for (k = 0; (p = scv_seg_segment(s, k, &n)) != NULL; ++k) {
+ *         // use p[0] .. p[n - 1]
+ *     }
+ * ~~~
+ *
+ * @param s pointer to `scv_seg`
+ * @param k segment number
+ * @param nobj pointer to where to store number of elements in segment
+ * @return pointer to elements of segment `k`, `NULL` if segment `k` has
+ *         no elements
+ */
+void *scv_seg_segment(struct scv_seg *s, size_t k, size_t *nobj);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* SCV_SEG_H_INCLUDED */
@@ -0,0 +1,1566 @@
+/*
+ * scv - Simple C Vector
+ *
+ * scv_sort.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if !defined(SCV_NO_THREADS)
+#  if defined(_WIN32)
+#    include <windows.h>
+#  else
+#    include <pthread.h>
+#    include <unistd.h>
+#  endif
+#endif
+
+#include "scv_sort.h"
+
+/**
+ * Ranges of at most this many elements are sorted by insertion sort.
+ */
+#define SCV_SORT_INSERTION (24)
+
+/**
+ * Ranges of more than this many elements use the median of three medians
+ * of three as pivot.
+ */
+#define SCV_SORT_NINTHER (128)
+
+/**
+ * Maximum number of elements moved by a partial insertion sort.
+ */
+#define SCV_SORT_PARTIAL_LIMIT (8)
+
+/**
+ * Number of elements examined at a time by block partitioning.
+ */
+#define SCV_SORT_BLOCK (64)
+
+/**
+ * Size of temporary element buffer in bytes. Insertion sort of larger
+ * elements uses swaps instead.
+ */
+#define SCV_SORT_TMP (256)
+
+/**
+ * Union of types with strict alignment requirements.
+ */
+union scv_sort_i_max_align {
+	long double ld;
+	double d;
+	long l;
+	void *p;
+	void (*fp)(void);
+};
+
+/**
+ * State of a sort.
+ */
+struct scv_sort_i_state {
+	size_t objsize;
+	int (*cmp)(const void *, const void *);
+	int (*cmp_ctx)(const void *, const void *, void *);
+	void *ctx;
+	union {
+		union scv_sort_i_max_align align;
+		char buf[SCV_SORT_TMP];
+	} tmp;
+};
+
+/**
+ * Return pointer to element number `i` of `base`.
+ */
+#define SCV_SORT_AT(s, base, i) ((base) + (i) * (s)->objsize)
+
+/**
+ * Return non-zero if the element at `a` is less than the element at `b`.
+ */
+#define SCV_SORT_LESS(s, a, b) \
+	(((s)->cmp != NULL ? (s)->cmp((a), (b)) \
+	                   : (s)->cmp_ctx((a), (b), (s)->ctx)) < 0)
+
+/**
+ * Swap `size` bytes at `a` and `b`.
+ *
+ * The common element sizes use fixed size copies, which compilers turn
+ * into a few register moves.
+ */
+static void scv_sort_i_swap(char *a, char *b, size_t size)
+{
+	char tmp[16];
+
+	switch (size) {
+	case 4:
+		memcpy(tmp, a, 4);
+		memcpy(a, b, 4);
+		memcpy(b, tmp, 4);
+		break;
+	case 8:
+		memcpy(tmp, a, 8);
+		memcpy(a, b, 8);
+		memcpy(b, tmp, 8);
+		break;
+	case 16:
+		memcpy(tmp, a, 16);
+		memcpy(a, b, 16);
+		memcpy(b, tmp, 16);
+		break;
+	default:
+		while (size >= 16) {
+			memcpy(tmp, a, 16);
+			memcpy(a, b, 16);
+			memcpy(b, tmp, 16);
+			a += 16;
+			b += 16;
+			size -= 16;
+		}
+		while (size > 0) {
+			char c = *a;
+			*a++ = *b;
+			*b++ = c;
+			--size;
+		}
+		break;
+	}
+}
+
+#define SCV_SORT_SWAP(s, a, b) scv_sort_i_swap((a), (b), (s)->objsize)
+
+/**
+ * Insert element number `i` of `base` into the sorted elements before it.
+ *
+ * @return number of elements moved
+ */
+static size_t scv_sort_i_insert(struct scv_sort_i_state *s, char *base, size_t i)
+{
+	size_t j = i;
+
+	if (s->objsize > SCV_SORT_TMP) {
+		while (j > 0 && SCV_SORT_LESS(s, SCV_SORT_AT(s, base, j), SCV_SORT_AT(s, base, j - 1))) {
+			SCV_SORT_SWAP(s, SCV_SORT_AT(s, base, j), SCV_SORT_AT(s, base, j - 1));
+			--j;
+		}
+
+		return i - j;
+	}
+
+	if (!SCV_SORT_LESS(s, SCV_SORT_AT(s, base, i), SCV_SORT_AT(s, base, i - 1))) {
+		return 0;
+	}
+
+	memcpy(s->tmp.buf, SCV_SORT_AT(s, base, i), s->objsize);
+
+	do {
+		--j;
+	} while (j > 0 && SCV_SORT_LESS(s, s->tmp.buf, SCV_SORT_AT(s, base, j - 1)));
+
+	memmove(SCV_SORT_AT(s, base, j + 1), SCV_SORT_AT(s, base, j), (i - j) * s->objsize);
+	memcpy(SCV_SORT_AT(s, base, j), s->tmp.buf, s->objsize);
+
+	return i - j;
+}
+
+static void scv_sort_i_insertion_sort(struct scv_sort_i_state *s, char *base, size_t n)
+{
+	size_t i;
+
+	for (i = 1; i < n; ++i) {
+		scv_sort_i_insert(s, base, i);
+	}
+}
+
+/**
+ * Insertion sort that gives up after moving `SCV_SORT_PARTIAL_LIMIT`
+ * elements.
+ *
+ * @return non-zero if the range was sorted
+ */
+static int scv_sort_i_partial_insertion_sort(struct scv_sort_i_state *s, char *base, size_t n)
+{
+	size_t moved = 0;
+	size_t i;
+
+	for (i = 1; i < n; ++i) {
+		moved += scv_sort_i_insert(s, base, i);
+
+		if (moved > SCV_SORT_PARTIAL_LIMIT) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static void scv_sort_i_sift_down(struct scv_sort_i_state *s, char *base, size_t i, size_t n)
+{
+	for (;;) {
+		size_t child = 2 * i + 1;
+
+		if (child >= n) {
+			break;
+		}
+
+		if (child + 1 < n
+		 && SCV_SORT_LESS(s, SCV_SORT_AT(s, base, child), SCV_SORT_AT(s, base, child + 1))) {
+			++child;
+		}
+
+		if (!SCV_SORT_LESS(s, SCV_SORT_AT(s, base, i), SCV_SORT_AT(s, base, child))) {
+			break;
+		}
+
+		SCV_SORT_SWAP(s, SCV_SORT_AT(s, base, i), SCV_SORT_AT(s, base, child));
+
+		i = child;
+	}
+}
+
+static void scv_sort_i_heapsort(struct scv_sort_i_state *s, char *base, size_t n)
+{
+	size_t i;
+
+	for (i = n / 2; i > 0; --i) {
+		scv_sort_i_sift_down(s, base, i - 1, n);
+	}
+
+	for (i = n; i > 1; --i) {
+		SCV_SORT_SWAP(s, base, SCV_SORT_AT(s, base, i - 1));
+		scv_sort_i_sift_down(s, base, 0, i - 1);
+	}
+}
+
+static void scv_sort_i_sort2(struct scv_sort_i_state *s, char *a, char *b)
+{
+	if (SCV_SORT_LESS(s, b, a)) {
+		SCV_SORT_SWAP(s, a, b);
+	}
+}
+
+/**
+ * Sort the elements at `a`, `b`, and `c`.
+ */
+static void scv_sort_i_sort3(struct scv_sort_i_state *s, char *a, char *b, char *c)
+{
+	scv_sort_i_sort2(s, a, b);
+	scv_sort_i_sort2(s, b, c);
+	scv_sort_i_sort2(s, a, b);
+}
+
+/**
+ * Swap elements at `n` pairs of offsets from `left` and `right`.
+ */
+static void scv_sort_i_swap_offsets(struct scv_sort_i_state *s, char *left, char *right,
+                                    const unsigned char *offsets_l,
+                                    const unsigned char *offsets_r, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; ++i) {
+		SCV_SORT_SWAP(s, SCV_SORT_AT(s, left, offsets_l[i]),
+		              right - offsets_r[i] * s->objsize);
+	}
+}
+
+/**
+ * Partition `n` elements at `base` around the pivot at `base`, placing
+ * elements less than the pivot before it.
+ *
+ * There must be an element at least as large as the pivot after it.
+ *
+ * To avoid branching on the result of comparisons, elements on the wrong
+ * side are found a block at a time, recording their offsets, and then
+ * swapped. This is from "BlockQuicksort: How Branch Mispredictions don't
+ * affect Quicksort" by Edelkamp and Weiss, as used in pdqsort.
+ *
+ * @param s pointer to sort state
+ * @param base pointer to elements
+ * @param n number of elements
+ * @param partitioned pointer to where to store non-zero if no elements
+ *        were swapped
+ * @return final index of pivot
+ */
+static size_t scv_sort_i_partition_right(struct scv_sort_i_state *s, char *base, size_t n,
+                                         int *partitioned)
+{
+	unsigned char offsets_l[SCV_SORT_BLOCK];
+	unsigned char offsets_r[SCV_SORT_BLOCK];
+	char *pivot = base;
+	char *first = base;
+	char *last = SCV_SORT_AT(s, base, n);
+	char *base_l;
+	char *base_r;
+	size_t num_l = 0;
+	size_t num_r = 0;
+	size_t start_l = 0;
+	size_t start_r = 0;
+	size_t objsize = s->objsize;
+	size_t pos;
+
+	do {
+		first += objsize;
+	} while (SCV_SORT_LESS(s, first, pivot));
+
+	if (first - objsize == base) {
+		do {
+			last -= objsize;
+		} while (first < last && !SCV_SORT_LESS(s, last, pivot));
+	}
+	else {
+		do {
+			last -= objsize;
+		} while (!SCV_SORT_LESS(s, last, pivot));
+	}
+
+	*partitioned = first >= last;
+
+	if (!*partitioned) {
+		SCV_SORT_SWAP(s, first, last);
+		first += objsize;
+
+		base_l = first;
+		base_r = last;
+
+		while (first < last) {
+			size_t unknown = (size_t) (last - first) / objsize;
+			size_t split_l = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+			size_t split_r = num_r == 0 ? unknown - split_l : 0;
+			size_t num;
+			size_t i;
+
+			if (split_l > SCV_SORT_BLOCK) {
+				split_l = SCV_SORT_BLOCK;
+			}
+
+			if (split_r > SCV_SORT_BLOCK) {
+				split_r = SCV_SORT_BLOCK;
+			}
+
+			for (i = 0; i < split_l; ++i) {
+				offsets_l[num_l] = (unsigned char) i;
+				num_l += !SCV_SORT_LESS(s, first, pivot);
+				first += objsize;
+			}
+
+			for (i = 0; i < split_r; ++i) {
+				last -= objsize;
+				offsets_r[num_r] = (unsigned char) (i + 1);
+				num_r += SCV_SORT_LESS(s, last, pivot);
+			}
+
+			num = num_l < num_r ? num_l : num_r;
+
+			scv_sort_i_swap_offsets(s, base_l, base_r, offsets_l + start_l,
+			                        offsets_r + start_r, num);
+
+			num_l -= num;
+			num_r -= num;
+			start_l += num;
+			start_r += num;
+
+			if (num_l == 0) {
+				start_l = 0;
+				base_l = first;
+			}
+
+			if (num_r == 0) {
+				start_r = 0;
+				base_r = last;
+			}
+		}
+
+		/* Move the remaining elements on the wrong side */
+		if (num_l > 0) {
+			while (num_l > 0) {
+				--num_l;
+				last -= objsize;
+				SCV_SORT_SWAP(s, SCV_SORT_AT(s, base_l, offsets_l[start_l + num_l]), last);
+			}
+			first = last;
+		}
+
+		if (num_r > 0) {
+			while (num_r > 0) {
+				--num_r;
+				SCV_SORT_SWAP(s, base_r - offsets_r[start_r + num_r] * objsize, first);
+				first += objsize;
+			}
+		}
+	}
+
+	pos = (size_t) (first - base) / objsize - 1;
+
+	if (pos != 0) {
+		SCV_SORT_SWAP(s, base, SCV_SORT_AT(s, base, pos));
+	}
+
+	return pos;
+}
+
+/**
+ * Partition `n` elements at `base` around the pivot at `base`, placing
+ * elements equal to the pivot before it.
+ *
+ * Used when the pivot equals the element before the range, so all
+ * elements before the returned index are equal to the pivot.
+ *
+ * @return final index of pivot
+ */
+static size_t scv_sort_i_partition_left(struct scv_sort_i_state *s, char *base, size_t n)
+{
+	char *pivot = base;
+	size_t i = 0;
+	size_t j = n;
+
+	do {
+		--j;
+	} while (SCV_SORT_LESS(s, pivot, SCV_SORT_AT(s, base, j)));
+
+	if (j + 1 == n) {
+		do {
+			++i;
+		} while (i < j && !SCV_SORT_LESS(s, pivot, SCV_SORT_AT(s, base, i)));
+	}
+	else {
+		do {
+			++i;
+		} while (!SCV_SORT_LESS(s, pivot, SCV_SORT_AT(s, base, i)));
+	}
+
+	while (i < j) {
+		SCV_SORT_SWAP(s, SCV_SORT_AT(s, base, i), SCV_SORT_AT(s, base, j));
+
+		do {
+			--j;
+		} while (SCV_SORT_LESS(s, pivot, SCV_SORT_AT(s, base, j)));
+
+		do {
+			++i;
+		} while (!SCV_SORT_LESS(s, pivot, SCV_SORT_AT(s, base, i)));
+	}
+
+	if (j != 0) {
+		SCV_SORT_SWAP(s, base, SCV_SORT_AT(s, base, j));
+	}
+
+	return j;
+}
+
+/**
+ * Sort `n` elements at `base`.
+ *
+ * @param s pointer to sort state
+ * @param base pointer to elements
+ * @param n number of elements
+ * @param bad number of unbalanced partitions allowed before switching
+ *        to heapsort
+ * @param leftmost non-zero if there is no element before `base` that is
+ *        known to be less than or equal to all elements of the range
+ */
+static void scv_sort_i_pdqsort(struct scv_sort_i_state *s, char *base, size_t n,
+                               int bad, int leftmost)
+{
+	while (n > SCV_SORT_INSERTION) {
+		size_t half = n / 2;
+		size_t pos;
+		size_t nl;
+		size_t nr;
+		int partitioned;
+
+		/* Choose pivot and move it to the start */
+		if (n > SCV_SORT_NINTHER) {
+			scv_sort_i_sort3(s, base, SCV_SORT_AT(s, base, half), SCV_SORT_AT(s, base, n - 1));
+			scv_sort_i_sort3(s, SCV_SORT_AT(s, base, 1), SCV_SORT_AT(s, base, half - 1),
+			                 SCV_SORT_AT(s, base, n - 2));
+			scv_sort_i_sort3(s, SCV_SORT_AT(s, base, 2), SCV_SORT_AT(s, base, half + 1),
+			                 SCV_SORT_AT(s, base, n - 3));
+			scv_sort_i_sort3(s, SCV_SORT_AT(s, base, half - 1), SCV_SORT_AT(s, base, half),
+			                 SCV_SORT_AT(s, base, half + 1));
+			SCV_SORT_SWAP(s, base, SCV_SORT_AT(s, base, half));
+		}
+		else {
+			scv_sort_i_sort3(s, SCV_SORT_AT(s, base, half), base, SCV_SORT_AT(s, base, n - 1));
+		}
+
+		/*
+		 * If the pivot equals the element before the range, there are
+		 * many equal elements. Put them all to the left and skip them.
+		 */
+		if (!leftmost && !SCV_SORT_LESS(s, base - s->objsize, base)) {
+			pos = scv_sort_i_partition_left(s, base, n);
+			base = SCV_SORT_AT(s, base, pos + 1);
+			n -= pos + 1;
+			continue;
+		}
+
+		pos = scv_sort_i_partition_right(s, base, n, &partitioned);
+
+		nl = pos;
+		nr = n - pos - 1;
+
+		if (nl < n / 8 || nr < n / 8) {
+			/* Unbalanced, fall back to heapsort if it keeps happening */
+			if (--bad == 0) {
+				scv_sort_i_heapsort(s, base, n);
+				return;
+			}
+
+			/* Break up patterns that may have caused it */
+			if (nl >= SCV_SORT_INSERTION) {
+				SCV_SORT_SWAP(s, base, SCV_SORT_AT(s, base, nl / 4));
+				SCV_SORT_SWAP(s, SCV_SORT_AT(s, base, pos - 1), SCV_SORT_AT(s, base, pos - nl / 4));
+			}
+
+			if (nr >= SCV_SORT_INSERTION) {
+				SCV_SORT_SWAP(s, SCV_SORT_AT(s, base, pos + 1),
+				              SCV_SORT_AT(s, base, pos + 1 + nr / 4));
+				SCV_SORT_SWAP(s, SCV_SORT_AT(s, base, n - 1),
+				              SCV_SORT_AT(s, base, n - nr / 4));
+			}
+		}
+		else if (partitioned
+		      && scv_sort_i_partial_insertion_sort(s, base, nl)
+		      && scv_sort_i_partial_insertion_sort(s, SCV_SORT_AT(s, base, pos + 1), nr)) {
+			/* Input was already sorted, or nearly so */
+			return;
+		}
+
+		/* Recurse into the smaller part, loop on the larger */
+		if (nl < nr) {
+			scv_sort_i_pdqsort(s, base, nl, bad, leftmost);
+			base = SCV_SORT_AT(s, base, pos + 1);
+			n = nr;
+			leftmost = 0;
+		}
+		else {
+			scv_sort_i_pdqsort(s, SCV_SORT_AT(s, base, pos + 1), nr, bad, 0);
+			n = nl;
+		}
+	}
+
+	scv_sort_i_insertion_sort(s, base, n);
+}
+
+/**
+ * Return the number of unbalanced partitions allowed for `n` elements,
+ * which is log2(n).
+ */
+static int scv_sort_i_bad_limit(size_t n)
+{
+	int log2 = 0;
+
+	while (n > 1) {
+		n >>= 1;
+		++log2;
+	}
+
+	return log2 > 0 ? log2 : 1;
+}
+
+static int scv_sort_i_run(struct scv_vector *v, struct scv_sort_i_state *s)
+{
+	char *base;
+	size_t n = scv_size(v);
+
+	if (n < 2) {
+		return SCV_OK;
+	}
+
+	base = (char *) scv_data(v);
+
+	scv_sort_i_pdqsort(s, base, n, scv_sort_i_bad_limit(n), 1);
+
+	return SCV_OK;
+}
+
+int scv_sort(struct scv_vector *v, int (*cmp)(const void *, const void *))
+{
+	struct scv_sort_i_state s;
+
+	assert(v != NULL);
+	assert(cmp != NULL);
+
+	s.objsize = scv_objsize(v);
+	s.cmp = cmp;
+	s.cmp_ctx = NULL;
+	s.ctx = NULL;
+
+	return scv_sort_i_run(v, &s);
+}
+
+int scv_sort_ctx(struct scv_vector *v,
+                 int (*cmp)(const void *, const void *, void *), void *ctx)
+{
+	struct scv_sort_i_state s;
+
+	assert(v != NULL);
+	assert(cmp != NULL);
+
+	s.objsize = scv_objsize(v);
+	s.cmp = NULL;
+	s.cmp_ctx = cmp;
+	s.ctx = ctx;
+
+	return scv_sort_i_run(v, &s);
+}
+
+/**
+ * Maximum key width for radix sort in bytes.
+ */
+#define SCV_RADIX_MAX_WIDTH (8)
+
+/**
+ * Copy `size` bytes from `src` to `dst`, with fixed size copies for the
+ * common element sizes.
+ */
+static void scv_sort_i_copy(char *dst, const char *src, size_t size)
+{
+	switch (size) {
+	case 4:
+		memcpy(dst, src, 4);
+		break;
+	case 8:
+		memcpy(dst, src, 8);
+		break;
+	case 16:
+		memcpy(dst, src, 16);
+		break;
+	default:
+		memcpy(dst, src, size);
+		break;
+	}
+}
+
+static int scv_sort_i_little_endian(void)
+{
+	unsigned int one = 1;
+
+	return *(unsigned char *) &one == 1;
+}
+
+/**
+ * Radix sort `n` elements at `data`, using `tmp` as buffer of the same
+ * size.
+ */
+static void scv_sort_i_radix(char *data, char *tmp, size_t n, size_t objsize,
+                             size_t key_offset, size_t key_width, unsigned int flags)
+{
+	size_t counts[SCV_RADIX_MAX_WIDTH][256];
+	size_t offsets[SCV_RADIX_MAX_WIDTH];
+	int little = scv_sort_i_little_endian();
+	char *src = data;
+	char *dst = tmp;
+	size_t d;
+	size_t i;
+
+	/* Offset of digit d, from the least significant byte */
+	for (d = 0; d < key_width; ++d) {
+		offsets[d] = key_offset + (little ? d : key_width - 1 - d);
+	}
+
+	/* Count all digits in one pass */
+	memset(counts, 0, sizeof counts);
+
+	for (i = 0; i < n; ++i) {
+		const unsigned char *key = (const unsigned char *) src + i * objsize;
+
+		for (d = 0; d < key_width; ++d) {
+			counts[d][key[offsets[d]]] += 1;
+		}
+	}
+
+	for (d = 0; d < key_width; ++d) {
+		size_t *count = counts[d];
+		char *p;
+		size_t sum = 0;
+		unsigned int flip = 0;
+		unsigned int b;
+
+		/* Skip the pass if all elements have the same digit */
+		if (count[((const unsigned char *) src)[offsets[d]]] == n) {
+			continue;
+		}
+
+		/* The sign bit is inverted, so negative keys come first */
+		if ((flags & SCV_RADIX_SIGNED) && d == key_width - 1) {
+			flip = 0x80;
+		}
+
+		for (b = 0; b < 256; ++b) {
+			size_t c = count[b ^ flip];
+
+			count[b ^ flip] = sum;
+			sum += c;
+		}
+
+		for (i = 0, p = src; i < n; ++i, p += objsize) {
+			unsigned char digit = ((const unsigned char *) p)[offsets[d]];
+
+			scv_sort_i_copy(dst + count[digit] * objsize, p, objsize);
+			count[digit] += 1;
+		}
+
+		p = src;
+		src = dst;
+		dst = p;
+	}
+
+	if (src != data) {
+		memcpy(data, src, n * objsize);
+	}
+}
+
+int scv_radix_sort_scratch(struct scv_vector *v, size_t key_offset, size_t key_width,
+                           unsigned int flags, struct scv_vector *scratch)
+{
+	size_t n;
+	int res;
+
+	assert(v != NULL);
+	assert(scratch != NULL);
+
+	if (key_width == 0 || key_width > SCV_RADIX_MAX_WIDTH
+	 || key_offset > scv_objsize(v) || key_width > scv_objsize(v) - key_offset
+	 || scv_objsize(scratch) != scv_objsize(v) || scratch == v) {
+		return SCV_EINVAL;
+	}
+
+	n = scv_size(v);
+
+	if (n < 2) {
+		return SCV_OK;
+	}
+
+	res = scv_resize(scratch, n);
+
+	if (res != SCV_OK) {
+		return res;
+	}
+
+	scv_sort_i_radix((char *) scv_data(v), (char *) scv_data(scratch), n,
+	                 scv_objsize(v), key_offset, key_width, flags);
+
+	return SCV_OK;
+}
+
+int scv_radix_sort(struct scv_vector *v, size_t key_offset, size_t key_width,
+                   unsigned int flags)
+{
+	struct scv_vector scratch;
+	int res;
+
+	assert(v != NULL);
+
+	res = scv_init(&scratch, scv_objsize(v));
+
+	if (res != SCV_OK) {
+		return res;
+	}
+
+	res = scv_radix_sort_scratch(v, key_offset, key_width, flags, &scratch);
+
+	scv_destroy(&scratch);
+
+	return res;
+}
+
+/**
+ * Vectors with fewer elements per thread than this are sorted serially.
+ */
+#define SCV_SORT_PARALLEL_GRAIN (32768)
+
+/**
+ * Maximum number of threads used by parallel sort.
+ */
+#define SCV_SORT_MAX_THREADS (256)
+
+enum {
+	SCV_SORT_I_SORT,
+	SCV_SORT_I_MERGE,
+	SCV_SORT_I_COPY
+};
+
+/**
+ * Work done by one thread in a phase of parallel sort.
+ *
+ * For `SCV_SORT_I_SORT`, elements `lo` to `hi` of `src` are sorted. For
+ * `SCV_SORT_I_MERGE`, elements `lo` to `hi` of the result of merging
+ * pairs of the runs in `src` are stored in `dst`. For `SCV_SORT_I_COPY`,
+ * elements `lo` to `hi` are copied from `src` to `dst`.
+ */
+struct scv_sort_i_task {
+	struct scv_sort_i_state state; /**< Sort state, with own buffer. */
+	int phase;                     /**< Work to do. */
+	char *src;                     /**< Source elements. */
+	char *dst;                     /**< Destination elements. */
+	size_t lo;                     /**< Start index. */
+	size_t hi;                     /**< End index. */
+	const size_t *runs;            /**< Run boundaries, `nruns + 1` entries. */
+	size_t nruns;                  /**< Number of runs. */
+};
+
+/**
+ * Return the number of elements from `a` among the first `k` elements of
+ * the stable merge of `a` and `b`.
+ *
+ * This is the merge path split used to let threads merge disjoint parts
+ * of the output.
+ */
+static size_t scv_sort_i_corank(struct scv_sort_i_state *s, size_t k,
+                                const char *a, size_t na, const char *b, size_t nb)
+{
+	size_t lo = k > nb ? k - nb : 0;
+	size_t hi = k < na ? k : na;
+
+	while (lo < hi) {
+		size_t i = lo + (hi - lo) / 2;
+		size_t j = k - i;
+
+		/* If a[i] does not come after b[j - 1], more of a is needed */
+		if (j > 0 && !SCV_SORT_LESS(s, SCV_SORT_AT(s, b, j - 1), SCV_SORT_AT(s, a, i))) {
+			lo = i + 1;
+		}
+		else {
+			hi = i;
+		}
+	}
+
+	return lo;
+}
+
+/**
+ * Store the stable merge of `na` elements at `a` and `nb` elements at `b`
+ * in `dst`.
+ */
+static void scv_sort_i_merge(struct scv_sort_i_state *s, char *dst,
+                             const char *a, size_t na, const char *b, size_t nb)
+{
+	size_t objsize = s->objsize;
+	const char *a_end = SCV_SORT_AT(s, a, na);
+	const char *b_end = SCV_SORT_AT(s, b, nb);
+
+	while (a < a_end && b < b_end) {
+		if (SCV_SORT_LESS(s, b, a)) {
+			scv_sort_i_copy(dst, b, objsize);
+			b += objsize;
+		}
+		else {
+			scv_sort_i_copy(dst, a, objsize);
+			a += objsize;
+		}
+
+		dst += objsize;
+	}
+
+	memcpy(dst, a, (size_t) (a_end - a));
+	memcpy(dst + (a_end - a), b, (size_t) (b_end - b));
+}
+
+static void scv_sort_i_do_merge(struct scv_sort_i_task *t)
+{
+	struct scv_sort_i_state *s = &t->state;
+	size_t p;
+
+	/* Handle the part of each pair of runs that overlaps [lo, hi) */
+	for (p = 0; p < t->nruns; p += 2) {
+		size_t start = t->runs[p];
+		size_t end = t->runs[p + 2 <= t->nruns ? p + 2 : t->nruns];
+		size_t lo = t->lo > start ? t->lo : start;
+		size_t hi = t->hi < end ? t->hi : end;
+		const char *a;
+		const char *b;
+		size_t na;
+		size_t nb;
+		size_t i0;
+		size_t i1;
+
+		if (lo >= hi) {
+			continue;
+		}
+
+		if (p + 1 == t->nruns) {
+			memcpy(SCV_SORT_AT(s, t->dst, lo), SCV_SORT_AT(s, t->src, lo),
+			       (hi - lo) * s->objsize);
+			continue;
+		}
+
+		a = SCV_SORT_AT(s, t->src, start);
+		na = t->runs[p + 1] - start;
+		b = SCV_SORT_AT(s, t->src, t->runs[p + 1]);
+		nb = end - t->runs[p + 1];
+
+		i0 = scv_sort_i_corank(s, lo - start, a, na, b, nb);
+		i1 = scv_sort_i_corank(s, hi - start, a, na, b, nb);
+
+		scv_sort_i_merge(s, SCV_SORT_AT(s, t->dst, lo),
+		                 SCV_SORT_AT(s, a, i0), i1 - i0,
+		                 SCV_SORT_AT(s, b, (lo - start) - i0),
+		                 (hi - start - i1) - (lo - start - i0));
+	}
+}
+
+static void scv_sort_i_do_task(struct scv_sort_i_task *t)
+{
+	struct scv_sort_i_state *s = &t->state;
+
+	switch (t->phase) {
+	case SCV_SORT_I_SORT:
+		scv_sort_i_pdqsort(s, SCV_SORT_AT(s, t->src, t->lo), t->hi - t->lo,
+		                   scv_sort_i_bad_limit(t->hi - t->lo), 1);
+		break;
+	case SCV_SORT_I_MERGE:
+		scv_sort_i_do_merge(t);
+		break;
+	case SCV_SORT_I_COPY:
+		memcpy(SCV_SORT_AT(s, t->dst, t->lo), SCV_SORT_AT(s, t->src, t->lo),
+		       (t->hi - t->lo) * s->objsize);
+		break;
+	}
+}
+
+#if !defined(SCV_NO_THREADS)
+#  if defined(_WIN32)
+
+typedef HANDLE scv_sort_i_thread;
+
+static DWORD WINAPI scv_sort_i_thread_proc(LPVOID arg)
+{
+	scv_sort_i_do_task((struct scv_sort_i_task *) arg);
+
+	return 0;
+}
+
+static int scv_sort_i_thread_start(scv_sort_i_thread *thread, struct scv_sort_i_task *t)
+{
+	*thread = CreateThread(NULL, 0, scv_sort_i_thread_proc, t, 0, NULL);
+
+	return *thread != NULL;
+}
+
+static void scv_sort_i_thread_join(scv_sort_i_thread thread)
+{
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+}
+
+static size_t scv_sort_i_ncpu(void)
+{
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+
+	return info.dwNumberOfProcessors;
+}
+
+#  else
+
+typedef pthread_t scv_sort_i_thread;
+
+static void *scv_sort_i_thread_proc(void *arg)
+{
+	scv_sort_i_do_task((struct scv_sort_i_task *) arg);
+
+	return NULL;
+}
+
+static int scv_sort_i_thread_start(scv_sort_i_thread *thread, struct scv_sort_i_task *t)
+{
+	return pthread_create(thread, NULL, scv_sort_i_thread_proc, t) == 0;
+}
+
+static void scv_sort_i_thread_join(scv_sort_i_thread thread)
+{
+	pthread_join(thread, NULL);
+}
+
+static size_t scv_sort_i_ncpu(void)
+{
+#    if defined(_SC_NPROCESSORS_ONLN)
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return n > 0 ? (size_t) n : 1;
+#    else
+	return 1;
+#    endif
+}
+
+#  endif
+#endif /* SCV_NO_THREADS */
+
+/**
+ * Run `ntasks` tasks, on separate threads where possible.
+ *
+ * The last task runs on the calling thread. If a thread cannot be started,
+ * its task runs on the calling thread instead.
+ */
+static void scv_sort_i_run_tasks(struct scv_sort_i_task *tasks, size_t ntasks)
+{
+#if !defined(SCV_NO_THREADS)
+	scv_sort_i_thread threads[SCV_SORT_MAX_THREADS];
+	int started[SCV_SORT_MAX_THREADS];
+	size_t i;
+
+	assert(ntasks <= SCV_SORT_MAX_THREADS);
+
+	for (i = 0; i + 1 < ntasks; ++i) {
+		started[i] = scv_sort_i_thread_start(&threads[i], &tasks[i]);
+
+		if (!started[i]) {
+			scv_sort_i_do_task(&tasks[i]);
+		}
+	}
+
+	scv_sort_i_do_task(&tasks[ntasks - 1]);
+
+	for (i = 0; i + 1 < ntasks; ++i) {
+		if (started[i]) {
+			scv_sort_i_thread_join(threads[i]);
+		}
+	}
+#else
+	size_t i;
+
+	for (i = 0; i < ntasks; ++i) {
+		scv_sort_i_do_task(&tasks[i]);
+	}
+#endif
+}
+
+/**
+ * Set up `ntasks` tasks for `phase`, splitting `n` elements evenly.
+ */
+static void scv_sort_i_split_tasks(struct scv_sort_i_task *tasks, size_t ntasks,
+                                   int phase, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < ntasks; ++i) {
+		tasks[i].phase = phase;
+		tasks[i].lo = n / ntasks * i + (i < n % ntasks ? i : n % ntasks);
+		tasks[i].hi = tasks[i].lo + n / ntasks + (i < n % ntasks ? 1 : 0);
+	}
+}
+
+int scv_sort_parallel(struct scv_vector *v, int (*cmp)(const void *, const void *),
+                      size_t nthreads)
+{
+	struct scv_sort_i_task *tasks;
+	struct scv_vector scratch;
+	size_t runs[SCV_SORT_MAX_THREADS + 1];
+	size_t nruns;
+	size_t objsize;
+	size_t n;
+	size_t i;
+	char *src;
+	char *dst;
+
+	assert(v != NULL);
+	assert(cmp != NULL);
+
+	n = scv_size(v);
+	objsize = scv_objsize(v);
+
+#if defined(SCV_NO_THREADS)
+	/* On one thread, splitting the work would only add merging */
+	nthreads = 1;
+#else
+	if (nthreads == 0) {
+		nthreads = scv_sort_i_ncpu();
+	}
+#endif
+
+	if (nthreads > SCV_SORT_MAX_THREADS) {
+		nthreads = SCV_SORT_MAX_THREADS;
+	}
+
+	if (nthreads > n / SCV_SORT_PARALLEL_GRAIN) {
+		nthreads = n / SCV_SORT_PARALLEL_GRAIN;
+	}
+
+	if (nthreads <= 1) {
+		return scv_sort(v, cmp);
+	}
+
+	/* If memory runs out, sorting serially still works */
+	if (scv_init(&scratch, objsize) != SCV_OK) {
+		return scv_sort(v, cmp);
+	}
+
+	if (scv_resize(&scratch, n) != SCV_OK) {
+		scv_destroy(&scratch);
+		return scv_sort(v, cmp);
+	}
+
+	tasks = (struct scv_sort_i_task *) malloc(nthreads * sizeof *tasks);
+
+	if (tasks == NULL) {
+		scv_destroy(&scratch);
+		return scv_sort(v, cmp);
+	}
+
+	src = (char *) scv_data(v);
+	dst = (char *) scv_data(&scratch);
+
+	for (i = 0; i < nthreads; ++i) {
+		tasks[i].state.objsize = objsize;
+		tasks[i].state.cmp = cmp;
+		tasks[i].state.cmp_ctx = NULL;
+		tasks[i].state.ctx = NULL;
+		tasks[i].src = src;
+		tasks[i].dst = dst;
+		tasks[i].runs = runs;
+	}
+
+	/* Sort one run per thread */
+	scv_sort_i_split_tasks(tasks, nthreads, SCV_SORT_I_SORT, n);
+	scv_sort_i_run_tasks(tasks, nthreads);
+
+	for (i = 0; i < nthreads; ++i) {
+		runs[i] = tasks[i].lo;
+	}
+
+	runs[nthreads] = n;
+	nruns = nthreads;
+
+	/* Merge pairs of runs, with all threads working on each round */
+	while (nruns > 1) {
+		scv_sort_i_split_tasks(tasks, nthreads, SCV_SORT_I_MERGE, n);
+
+		for (i = 0; i < nthreads; ++i) {
+			tasks[i].src = src;
+			tasks[i].dst = dst;
+			tasks[i].nruns = nruns;
+		}
+
+		scv_sort_i_run_tasks(tasks, nthreads);
+
+		for (i = 0; 2 * i < nruns; ++i) {
+			runs[i] = runs[2 * i];
+		}
+
+		runs[i] = n;
+		nruns = i;
+
+		dst = src;
+		src = tasks[0].dst;
+	}
+
+	if (src != (char *) scv_data(v)) {
+		scv_sort_i_split_tasks(tasks, nthreads, SCV_SORT_I_COPY, n);
+
+		for (i = 0; i < nthreads; ++i) {
+			tasks[i].src = src;
+			tasks[i].dst = dst;
+		}
+
+		scv_sort_i_run_tasks(tasks, nthreads);
+	}
+
+	free(tasks);
+	scv_destroy(&scratch);
+
+	return SCV_OK;
+}
+
+/**
+ * Natural runs shorter than this are extended by insertion sort.
+ */
+#define SCV_SORT_MIN_RUN (32)
+
+/**
+ * Maximum number of pending runs in stable sort.
+ *
+ * Run powers on the stack are strictly increasing, and at most one more
+ * than the number of bits in `size_t`.
+ */
+#define SCV_SORT_MAX_PENDING (sizeof(size_t) * CHAR_BIT + 2)
+
+/**
+ * Run waiting to be merged in stable sort.
+ */
+struct scv_sort_i_run {
+	size_t start; /**< Index of first element. */
+	size_t len;   /**< Number of elements. */
+	size_t power; /**< Power of boundary to the following run. */
+};
+
+/**
+ * Return the index of the first element of `base` that is greater than
+ * the element at `key`.
+ */
+static size_t scv_sort_i_upper_bound(struct scv_sort_i_state *s, const char *base,
+                                     size_t n, const char *key)
+{
+	size_t lo = 0;
+
+	while (n > 0) {
+		size_t half = n / 2;
+
+		if (SCV_SORT_LESS(s, key, SCV_SORT_AT(s, base, lo + half))) {
+			n = half;
+		}
+		else {
+			lo += half + 1;
+			n -= half + 1;
+		}
+	}
+
+	return lo;
+}
+
+/**
+ * Return the index of the first element of `base` that is not less than
+ * the element at `key`.
+ */
+static size_t scv_sort_i_lower_bound(struct scv_sort_i_state *s, const char *base,
+                                     size_t n, const char *key)
+{
+	size_t lo = 0;
+
+	while (n > 0) {
+		size_t half = n / 2;
+
+		if (SCV_SORT_LESS(s, SCV_SORT_AT(s, base, lo + half), key)) {
+			lo += half + 1;
+			n -= half + 1;
+		}
+		else {
+			n = half;
+		}
+	}
+
+	return lo;
+}
+
+/**
+ * Return the length of the run starting at `base`, reversing it if it is
+ * strictly descending.
+ *
+ * Only strictly descending runs are reversed, so equal elements keep their
+ * order.
+ */
+static size_t scv_sort_i_find_run(struct scv_sort_i_state *s, char *base, size_t n)
+{
+	size_t i = 1;
+
+	if (n < 2) {
+		return n;
+	}
+
+	if (SCV_SORT_LESS(s, SCV_SORT_AT(s, base, 1), base)) {
+		size_t lo;
+		size_t hi;
+
+		while (i + 1 < n
+		    && SCV_SORT_LESS(s, SCV_SORT_AT(s, base, i + 1), SCV_SORT_AT(s, base, i))) {
+			++i;
+		}
+
+		for (lo = 0, hi = i; lo < hi; ++lo, --hi) {
+			SCV_SORT_SWAP(s, SCV_SORT_AT(s, base, lo), SCV_SORT_AT(s, base, hi));
+		}
+	}
+	else {
+		while (i + 1 < n
+		    && !SCV_SORT_LESS(s, SCV_SORT_AT(s, base, i + 1), SCV_SORT_AT(s, base, i))) {
+			++i;
+		}
+	}
+
+	return i + 1;
+}
+
+/**
+ * Return the length of the run starting at `base`, extended to at least
+ * `SCV_SORT_MIN_RUN` elements, or `n` if fewer, by insertion sort.
+ */
+static size_t scv_sort_i_next_run(struct scv_sort_i_state *s, char *base, size_t n)
+{
+	size_t len = scv_sort_i_find_run(s, base, n);
+	size_t min_len = n < SCV_SORT_MIN_RUN ? n : SCV_SORT_MIN_RUN;
+
+	/* Find where to insert by binary search, since comparisons are more
+	 * expensive than moving elements */
+	for (; len < min_len; ++len) {
+		char *p = SCV_SORT_AT(s, base, len);
+		size_t j;
+
+		if (s->objsize > SCV_SORT_TMP) {
+			scv_sort_i_insert(s, base, len);
+			continue;
+		}
+
+		j = scv_sort_i_upper_bound(s, base, len, p);
+
+		if (j < len) {
+			memcpy(s->tmp.buf, p, s->objsize);
+			memmove(SCV_SORT_AT(s, base, j + 1), SCV_SORT_AT(s, base, j),
+			        (len - j) * s->objsize);
+			memcpy(SCV_SORT_AT(s, base, j), s->tmp.buf, s->objsize);
+		}
+	}
+
+	return len;
+}
+
+/**
+ * Return the powersort power of the boundary between a run of `n1`
+ * elements starting at index `s1` and the following run of `n2` elements,
+ * out of `n` elements in total.
+ *
+ * This is the depth of the node in a perfectly balanced merge tree over
+ * [0, n) which separates the midpoints of the two runs.
+ */
+static size_t scv_sort_i_power(size_t s1, size_t n1, size_t n2, size_t n)
+{
+	/* Midpoints times two, compared to n as binary fractions of 2n */
+	size_t a = 2 * s1 + n1;
+	size_t b = a + n1 + n2;
+	size_t power = 0;
+
+	for (;;) {
+		++power;
+
+		if (a >= n) {
+			a -= n;
+			b -= n;
+		}
+		else if (b >= n) {
+			break;
+		}
+
+		a <<= 1;
+		b <<= 1;
+	}
+
+	return power;
+}
+
+/**
+ * Merge the sorted runs of `na` and `nb` elements at `base`, using `tmp`
+ * to hold the shorter of them.
+ */
+static void scv_sort_i_merge_runs(struct scv_sort_i_state *s, char *base,
+                                  size_t na, size_t nb, char *tmp)
+{
+	size_t objsize = s->objsize;
+	char *a;
+	char *b;
+	char *dst;
+	size_t k;
+
+	/* Elements of the first run not greater than the start of the second
+	 * are already in place, as are elements of the second run not less
+	 * than the end of the first */
+	k = scv_sort_i_upper_bound(s, base, na, SCV_SORT_AT(s, base, na));
+	base = SCV_SORT_AT(s, base, k);
+	na -= k;
+
+	if (na == 0) {
+		return;
+	}
+
+	nb = scv_sort_i_lower_bound(s, SCV_SORT_AT(s, base, na), nb,
+	                            SCV_SORT_AT(s, base, na - 1));
+
+	if (na <= nb) {
+		/* Copy first run to tmp and merge forwards */
+		const char *a_end;
+		const char *b_end = SCV_SORT_AT(s, base, na + nb);
+
+		memcpy(tmp, base, na * objsize);
+
+		a = tmp;
+		a_end = SCV_SORT_AT(s, tmp, na);
+		b = SCV_SORT_AT(s, base, na);
+		dst = base;
+
+		while (a < a_end && b < b_end) {
+			if (SCV_SORT_LESS(s, b, a)) {
+				scv_sort_i_copy(dst, b, objsize);
+				b += objsize;
+			}
+			else {
+				scv_sort_i_copy(dst, a, objsize);
+				a += objsize;
+			}
+
+			dst += objsize;
+		}
+
+		if (a < a_end) {
+			memcpy(dst, a, (size_t) (a_end - a));
+		}
+	}
+	else {
+		/* Copy second run to tmp and merge backwards */
+		char *b_start = tmp;
+
+		memcpy(tmp, SCV_SORT_AT(s, base, na), nb * objsize);
+
+		a = SCV_SORT_AT(s, base, na);
+		b = SCV_SORT_AT(s, tmp, nb);
+		dst = SCV_SORT_AT(s, base, na + nb);
+
+		while (a > base && b > b_start) {
+			dst -= objsize;
+
+			if (SCV_SORT_LESS(s, b - objsize, a - objsize)) {
+				a -= objsize;
+				scv_sort_i_copy(dst, a, objsize);
+			}
+			else {
+				b -= objsize;
+				scv_sort_i_copy(dst, b, objsize);
+			}
+		}
+
+		if (b > b_start) {
+			memcpy(base, b_start, (size_t) (b - b_start));
+		}
+	}
+}
+
+/**
+ * Stable sort `n` elements at `base` using `tmp` for at least `n / 2`
+ * elements.
+ *
+ * Natural runs are found from left to right, extended to at least
+ * `SCV_SORT_MIN_RUN` elements by insertion sort, and merged in the order
+ * given by powersort, which is close to an optimal merge tree for the runs.
+ */
+static void scv_sort_i_stable(struct scv_sort_i_state *s, char *base, size_t n,
+                              char *tmp)
+{
+	struct scv_sort_i_run stack[SCV_SORT_MAX_PENDING];
+	size_t top = 0;
+	size_t start = 0;
+	size_t len;
+
+	len = scv_sort_i_next_run(s, base, n);
+
+	for (;;) {
+		size_t next_start = start + len;
+		size_t next_len;
+		size_t power;
+
+		if (next_start == n) {
+			break;
+		}
+
+		next_len = scv_sort_i_next_run(s, SCV_SORT_AT(s, base, next_start), n - next_start);
+
+		power = scv_sort_i_power(start, len, next_len, n);
+
+		/* Merge pending runs that end at a deeper node of the merge tree */
+		while (top > 0 && stack[top - 1].power > power) {
+			--top;
+			scv_sort_i_merge_runs(s, SCV_SORT_AT(s, base, stack[top].start),
+			                      stack[top].len, len, tmp);
+			len += stack[top].len;
+			start = stack[top].start;
+		}
+
+		assert(top < SCV_SORT_MAX_PENDING);
+
+		stack[top].start = start;
+		stack[top].len = len;
+		stack[top].power = power;
+		++top;
+
+		start = next_start;
+		len = next_len;
+	}
+
+	while (top > 0) {
+		--top;
+		scv_sort_i_merge_runs(s, SCV_SORT_AT(s, base, stack[top].start),
+		                      stack[top].len, len, tmp);
+		len += stack[top].len;
+	}
+}
+
+int scv_stable_sort_scratch(struct scv_vector *v, int (*cmp)(const void *, const void *),
+                            struct scv_vector *scratch)
+{
+	struct scv_sort_i_state s;
+	size_t n;
+	int res;
+
+	assert(v != NULL);
+	assert(cmp != NULL);
+	assert(scratch != NULL);
+
+	if (scv_objsize(scratch) != scv_objsize(v) || scratch == v) {
+		return SCV_EINVAL;
+	}
+
+	n = scv_size(v);
+
+	if (n < 2) {
+		return SCV_OK;
+	}
+
+	s.objsize = scv_objsize(v);
+	s.cmp = cmp;
+	s.cmp_ctx = NULL;
+	s.ctx = NULL;
+
+	/* Short vectors are sorted by insertion sort, which needs no scratch */
+	if (n <= SCV_SORT_MIN_RUN) {
+		scv_sort_i_insertion_sort(&s, (char *) scv_data(v), n);
+
+		return SCV_OK;
+	}
+
+	res = scv_resize(scratch, n / 2);
+
+	if (res != SCV_OK) {
+		return res;
+	}
+
+	scv_sort_i_stable(&s, (char *) scv_data(v), n, (char *) scv_data(scratch));
+
+	return SCV_OK;
+}
+
+int scv_stable_sort(struct scv_vector *v, int (*cmp)(const void *, const void *))
+{
+	struct scv_vector scratch;
+	int res;
+
+	assert(v != NULL);
+
+	res = scv_init(&scratch, scv_objsize(v));
+
+	if (res != SCV_OK) {
+		return res;
+	}
+
+	res = scv_stable_sort_scratch(v, cmp, &scratch);
+
+	scv_destroy(&scratch);
+
+	return res;
+}
@@ -0,0 +1,187 @@
+/*
+ * scv - Simple C Vector
+ *
+ * scv_sort.h
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SCV_SORT_H_INCLUDED
+#define SCV_SORT_H_INCLUDED
+
+#include "scv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Sort the elements of `v` in ascending order according to `cmp`.
+ *
+ * `cmp` is called like the comparison function of `qsort()`, and must
+ * return a negative value, zero, or a positive value if the first
+ * element is less than, equal to, or greater than the second.
+ *
+ * The sort is not stable. It is a pattern-defeating quicksort, which runs in
+ * O(n log n) time in the worst case and linear time on sorted input.
+ * Elements of size 4, 8, and 16 bytes are swapped without a byte loop.
+ *
+ * @param v pointer to `scv_vector`
+ * @param cmp pointer to comparison function
+ * @return zero on success, error code on error
+ */
+int scv_sort(struct scv_vector *v, int (*cmp)(const void *, const void *));
+
+/**
+ * Sort the elements of `v` in ascending order according to `cmp`, which
+ * is passed `ctx` as its third argument.
+ *
+ * @see scv_sort
+ *
+ * @param v pointer to `scv_vector`
+ * @param cmp pointer to comparison function
+ * @param ctx pointer passed to `cmp`
+ * @return zero on success, error code on error
+ */
+int scv_sort_ctx(struct scv_vector *v,
+                 int (*cmp)(const void *, const void *, void *), void *ctx);
+
+/**
+ * Flags for `scv_radix_sort()`.
+ */
+typedef enum {
+	SCV_RADIX_UNSIGNED = 0,     /**< Key is an unsigned integer. */
+	SCV_RADIX_SIGNED = (1 << 0) /**< Key is a two's complement signed integer. */
+} scv_radix_flags;
+
+/**
+ * Sort the elements of `v` in ascending order of an integer key.
+ *
+ * The key is `key_width` bytes at offset `key_offset` in each element, in
+ * the byte order of the machine, like an `int` or `long` member of a
+ * structure.
+ *
+ * The sort is a stable LSD radix sort, using one pass per byte of the key.
+ * Passes where all keys have the same value of that byte are skipped.
+ *
+ * A temporary buffer the size of `v` is allocated. Use
+ * `scv_radix_sort_scratch()` to reuse one across calls.
+ *
+ * @param v pointer to `scv_vector`
+ * @param key_offset offset of key in each element in bytes
+ * @param key_width size of key in bytes, from 1 to 8
+ * @param flags `SCV_RADIX_UNSIGNED` or `SCV_RADIX_SIGNED`
+ * @return zero on success, error code on error
+ */
+int scv_radix_sort(struct scv_vector *v, size_t key_offset, size_t key_width,
+                   unsigned int flags);
+
+/**
+ * Sort the elements of `v` in ascending order of an integer key, using
+ * `scratch` as temporary buffer.
+ *
+ * `scratch` is resized to the size of `v`, and keeps its capacity, so
+ * sorting repeatedly with the same `scratch` does not allocate memory
+ * once it is large enough. The contents of `scratch` are unspecified
+ * afterwards.
+ *
+ * @see scv_radix_sort
+ *
+ * @param v pointer to `scv_vector`
+ * @param key_offset offset of key in each element in bytes
+ * @param key_width size of key in bytes, from 1 to 8
+ * @param flags `SCV_RADIX_UNSIGNED` or `SCV_RADIX_SIGNED`
+ * @param scratch pointer to `scv_vector` with the same `objsize` as `v`
+ * @return zero on success, error code on error
+ */
+int scv_radix_sort_scratch(struct scv_vector *v, size_t key_offset, size_t key_width,
+                           unsigned int flags, struct scv_vector *scratch);
+
+/**
+ * Sort the elements of `v` in ascending order according to `cmp`, using
+ * up to `nthreads` threads.
+ *
+ * The vector is split into one part per thread, which are sorted
+ * concurrently and then merged in rounds, with all threads sharing the
+ * work of each round. The sort is not stable.
+ *
+ * Each thread is given at least 32768 elements, so small vectors are
+ * sorted by `scv_sort()` on the calling thread. If `nthreads` is zero, the
+ * number of online processors is used.
+ *
+ * A temporary buffer the size of `v` is allocated. If allocation fails,
+ * `v` is sorted by `scv_sort()` instead.
+ *
+ * `cmp` is called from several threads at once, so it must not modify
+ * shared state.
+ *
+ * If the library is built with `SCV_NO_THREADS` defined, `v` is sorted by
+ * `scv_sort()` on the calling thread, whatever the value of `nthreads`.
+ *
+ * @param v pointer to `scv_vector`
+ * @param cmp pointer to comparison function
+ * @param nthreads maximum number of threads, or zero for one per processor
+ * @return zero on success, error code on error
+ */
+int scv_sort_parallel(struct scv_vector *v, int (*cmp)(const void *, const void *),
+                      size_t nthreads);
+
+/**
+ * Stable sort the elements of `v` in ascending order according to `cmp`.
+ *
+ * Equal elements keep their relative order, so sorting by one key and then
+ * by another orders by the second key, then the first.
+ *
+ * The sort is an adaptive merge sort, which finds ascending and strictly
+ * descending runs already present in `v` and merges them in the order
+ * given by powersort. It runs in linear time on sorted input, and is fast
+ * on input that is nearly sorted or consists of a few sorted parts.
+ *
+ * A temporary buffer of half the size of `v` is allocated. Use
+ * `scv_stable_sort_scratch()` to reuse one across calls.
+ *
+ * @param v pointer to `scv_vector`
+ * @param cmp pointer to comparison function
+ * @return zero on success, error code on error
+ */
+int scv_stable_sort(struct scv_vector *v, int (*cmp)(const void *, const void *));
+
+/**
+ * Stable sort the elements of `v` in ascending order according to `cmp`,
+ * using `scratch` as temporary buffer.
+ *
+ * `scratch` is resized to half the size of `v`, and keeps its capacity, so
+ * sorting repeatedly with the same `scratch` does not allocate memory
+ * once it is large enough. The contents of `scratch` are unspecified
+ * afterwards.
+ *
+ * @see scv_stable_sort
+ *
+ * @param v pointer to `scv_vector`
+ * @param cmp pointer to comparison function
+ * @param scratch pointer to `scv_vector` with the same `objsize` as `v`
+ * @return zero on success, error code on error
+ */
+int scv_stable_sort_scratch(struct scv_vector *v, int (*cmp)(const void *, const void *),
+                            struct scv_vector *scratch);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* SCV_SORT_H_INCLUDED */
@@ -56,581 +56,2003 @@ static int check_int_vector(struct scv_vector *v)
 	return 1;
 }
 
+struct count_allocator {
+	size_t nalloc;
+	size_t nrealloc;
+	size_t nfree;
+	size_t bytes;
+	size_t limit; /* Larger allocations fail, zero for no limit */
+};
+
+static void *count_allocate(void *ctx, size_t size)
+{
+	struct count_allocator *ca = ctx;
+	void *p;
+
+	if (ca->limit != 0 && size > ca->limit) {
+		return NULL;
+	}
+
+	p = malloc(size);
+
+	if (p != NULL) {
+		ca->nalloc += 1;
+		ca->bytes += size;
+	}
+
+	return p;
+}
+
+static void *count_reallocate(void *ctx, void *ptr, size_t oldsize, size_t newsize)
+{
+	struct count_allocator *ca = ctx;
+	void *p = realloc(ptr, newsize);
+
+	if (p != NULL) {
+		ca->nrealloc += 1;
+		ca->bytes = ca->bytes - oldsize + newsize;
+	}
+
+	return p;
+}
+
+static void count_deallocate(void *ctx, void *ptr, size_t size)
+{
+	struct count_allocator *ca = ctx;
+
+	ca->nfree += 1;
+	ca->bytes -= size;
+
+	free(ptr);
+}
+
 /* scv_new */
 
 TEST new_objsize_zero(void)
 {
 	struct scv_vector *v;
 
-	v = scv_new(0, 1);
+	v = scv_new(0, 1);
+
+	ASSERT(v == NULL);
+
+	PASS();
+}
+
+TEST new_capacity_zero(void)
+{
+	struct scv_vector *v;
+
+	v = scv_new(1, 0);
+
+	ASSERT(v != NULL);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST new_capacity_zero_no_data(void)
+{
+	struct count_allocator ca = { 0, 0, 0, 0, 0 };
+	struct scv_allocator a;
+	struct scv_vector *v;
+	int i;
+
+	a.allocate = count_allocate;
+	a.reallocate = count_reallocate;
+	a.deallocate = count_deallocate;
+	a.ctx = &ca;
+
+	v = scv_new_with_allocator(sizeof(int), 0, &a);
+
+	/* The structure and the state holding the allocator */
+	ASSERT(v != NULL && v->data == NULL && ca.nalloc == 2);
+	ASSERT(scv_capacity(v) == 0 && scv_empty(v));
+	ASSERT(scv_data(v) == NULL && scv_front(v) == NULL && scv_back(v) == NULL);
+	ASSERT(scv_at(v, 0) == NULL);
+
+	ASSERT(scv_shrink_to_fit(v) == SCV_OK && scv_clear(v) == SCV_OK);
+	ASSERT(scv_resize(v, 0) == SCV_OK && v->data == NULL);
+
+	for (i = 0; i < 10; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	ASSERT(ca.nalloc == 3 && check_int_vector(v));
+
+	scv_delete(v);
+
+	ASSERT(ca.nfree == 3 && ca.bytes == 0);
+
+	PASS();
+}
+
+TEST new_capacity_zero_reserve(void)
+{
+	struct scv_vector *v;
+
+	v = scv_new(sizeof(int), 0);
+
+	ASSERT(scv_reserve(v, 5) == SCV_OK && scv_capacity(v) == 5);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST new_capacity_zero_copy(void)
+{
+	struct scv_vector *v1;
+	struct scv_vector *v2;
+
+	v1 = scv_new(sizeof(int), 0);
+	v2 = scv_new(sizeof(int), 0);
+
+	ASSERT(scv_copy(v1, v2) == SCV_OK && scv_empty(v1) && v1->data == NULL);
+
+	scv_delete(v1);
+	scv_delete(v2);
+
+	PASS();
+}
+
+TEST new_objsize_max(void)
+{
+	struct scv_vector *v;
+
+	v = scv_new((size_t) -1, 0);
+
+	ASSERT(v == NULL);
+
+	PASS();
+}
+
+TEST new_capacity_max(void)
+{
+	struct scv_vector *v;
+
+	v = scv_new(1, (size_t) -1);
+
+	ASSERT(v == NULL);
+
+	PASS();
+}
+
+/* scv_new_with_allocator */
+
+TEST new_with_allocator(void)
+{
+	struct count_allocator ca = { 0, 0, 0, 0, 0 };
+	struct scv_allocator a;
+	struct scv_vector *v;
+	size_t hdr;
+	int i;
+
+	a.allocate = count_allocate;
+	a.reallocate = count_reallocate;
+	a.deallocate = count_deallocate;
+	a.ctx = &ca;
+
+	v = scv_new_with_allocator(sizeof(int), 25, &a);
+
+	/* The structure, the state holding the allocator, and the elements */
+	ASSERT(v != NULL && ca.nalloc == 3);
+
+	hdr = ca.bytes - scv_capacity(v) * sizeof(int);
+
+	ASSERT(hdr > sizeof *v);
+
+	for (i = 0; i < 1000; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	ASSERT(check_int_vector(v));
+	ASSERT(ca.nrealloc > 0 && ca.bytes >= hdr + 1000 * sizeof(int));
+
+	scv_shrink_to_fit(v);
+
+	ASSERT(ca.bytes == hdr + 1000 * sizeof(int));
+
+	scv_delete(v);
+
+	ASSERT(ca.nfree == ca.nalloc && ca.bytes == 0);
+
+	PASS();
+}
+
+TEST new_with_allocator_null(void)
+{
+	struct scv_vector *v;
+
+	v = scv_new_with_allocator(sizeof(int), 25, NULL);
+
+	ASSERT(v != NULL && v->ext == NULL && scv_capacity(v) >= 25);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_arena */
+
+TEST arena_grow_in_place(void)
+{
+	struct scv_arena *arena;
+	struct scv_vector *v;
+	void *p;
+	int i;
+
+	arena = scv_arena_new(0);
+
+	ASSERT(arena != NULL);
+
+	v = scv_new_with_allocator(sizeof(int), 16, scv_arena_allocator(arena));
+
+	ASSERT(v != NULL);
+
+	p = v->data;
+
+	for (i = 0; i < 1000; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	ASSERT(check_int_vector(v) && v->data == p);
+
+	scv_delete(v);
+
+	scv_arena_delete(arena);
+
+	PASS();
+}
+
+TEST arena_many_vectors(void)
+{
+	struct scv_arena *arena;
+	struct scv_vector *v[10];
+	size_t i;
+	int j;
+
+	arena = scv_arena_new(256);
+
+	ASSERT(arena != NULL);
+
+	for (i = 0; i < ARRAY_SIZE(v); ++i) {
+		v[i] = scv_new_with_allocator(sizeof(int), 1, scv_arena_allocator(arena));
+		ASSERT(v[i] != NULL);
+	}
+
+	for (j = 0; j < 500; ++j) {
+		for (i = 0; i < ARRAY_SIZE(v); ++i) {
+			scv_push_back(v[i], &j);
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(v); ++i) {
+		ASSERT(scv_size(v[i]) == 500 && check_int_vector(v[i]));
+	}
+
+	scv_arena_reset(arena);
+
+	v[0] = scv_new_with_allocator(sizeof(int), 1, scv_arena_allocator(arena));
+
+	ASSERT(v[0] != NULL && scv_empty(v[0]));
+
+	scv_arena_delete(arena);
+
+	PASS();
+}
+
+TEST arena_unaligned_blocksize(void)
+{
+	const struct scv_allocator *a;
+	struct scv_arena *arena;
+	char *p;
+	char *q;
+
+	arena = scv_arena_new(100);
+
+	ASSERT(arena != NULL);
+
+	a = scv_arena_allocator(arena);
+
+	p = (char *) a->allocate(a->ctx, 32);
+
+	ASSERT(p != NULL);
+
+	/* Grow to the requested block size in place */
+	p = (char *) a->reallocate(a->ctx, p, 32, 100);
+
+	ASSERT(p != NULL);
+
+	memset(p, 0xAA, 100);
+
+	q = (char *) a->allocate(a->ctx, 16);
+
+	ASSERT(q != NULL);
+	ASSERT(q >= p + 100 || q + 16 <= p);
+
+	memset(q, 0x55, 16);
+
+	ASSERT_EQ((unsigned char) p[99], 0xAA);
+
+	scv_arena_delete(arena);
+
+	PASS();
+}
+
+TEST arena_delete_null(void)
+{
+	scv_arena_delete(NULL);
+
+	PASS();
+}
+
+/* scv_new_aligned */
+
+TEST new_aligned(void)
+{
+	struct scv_vector *v;
+	int i;
+
+	v = scv_new_aligned(sizeof(int), 3, 64);
+
+	ASSERT(v != NULL && ((size_t) v->data & 63) == 0);
+
+	for (i = 0; i < 1000; ++i) {
+		scv_push_back(v, &i);
+		ASSERT(((size_t) scv_data(v) & 63) == 0);
+	}
+
+	ASSERT(check_int_vector(v));
+
+	scv_reserve(v, 5000);
+
+	ASSERT(((size_t) scv_data(v) & 63) == 0 && check_int_vector(v));
+
+	scv_resize(v, 100);
+	scv_shrink_to_fit(v);
+
+	ASSERT(((size_t) scv_data(v) & 63) == 0 && check_int_vector(v));
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST new_aligned_not_power_of_two(void)
+{
+	struct scv_vector *v;
+
+	v = scv_new_aligned(sizeof(int), 10, 24);
+
+	ASSERT(v == NULL);
+
+	v = scv_new_aligned(sizeof(int), 10, 0);
+
+	ASSERT(v == NULL);
+
+	PASS();
+}
+
+/* scv_new_small */
+
+TEST new_small(void)
+{
+	struct scv_vector *v;
+	int i;
+
+	v = scv_new_small(sizeof(int), 4);
+
+	ASSERT(v != NULL && scv_capacity(v) == 4);
+	ASSERT((char *) v->data > (char *) v && (char *) v->data < (char *) v + sizeof *v + 64);
+
+	for (i = 0; i < 4; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	ASSERT(scv_capacity(v) == 4 && check_int_vector(v));
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST struct_size(void)
+{
+#if !defined(SCV_STATS)
+	/* Leaves room for elements in one cache line with scv_new_small() */
+	ASSERT(sizeof(struct scv_vector) <= 6 * sizeof(size_t));
+#endif
+
+	PASS();
+}
+
+TEST new_small_layout(void)
+{
+	struct scv_vector *v;
+	char *data;
+	int i;
+
+	v = scv_new_small(sizeof(int), 4);
+
+	ASSERT(v != NULL);
+
+	for (i = 0; i < 4; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	data = (char *) scv_data(v);
+
+	/* Header is at the start of a cache line, followed by the elements */
+	ASSERT(((size_t) v & 63) == 0);
+	ASSERT(data >= (char *) (v + 1) && data < (char *) (v + 1) + 64);
+	ASSERT(((size_t) data & (sizeof(int) - 1)) == 0);
+
+#if !defined(SCV_STATS)
+	/* The header and all inline elements share one cache line */
+	ASSERT(data + 4 * sizeof(int) <= (char *) v + 64);
+#endif
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST new_small_spill(void)
+{
+	struct scv_vector *v;
+	int i;
+
+	v = scv_new_small(sizeof(int), 4);
+
+	for (i = 0; i < 100; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	ASSERT(scv_size(v) == 100 && check_int_vector(v));
+
+	scv_shrink_to_fit(v);
+
+	ASSERT(scv_capacity(v) == 100 && check_int_vector(v));
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST new_small_swap(void)
+{
+	struct scv_vector *v1;
+	struct scv_vector *v2;
+	int i;
+	int res;
+
+	v1 = scv_new_small(sizeof(int), 4);
+	v2 = scv_new_small(sizeof(int), 4);
+
+	for (i = 0; i < 3; ++i) {
+		scv_push_back(v1, &i);
+	}
+
+	res = scv_swap(v1, v2);
+
+	ASSERT(res == SCV_OK && scv_empty(v1) && scv_size(v2) == 3);
+
+	scv_delete(v1);
+
+	ASSERT(check_int_vector(v2));
+
+	scv_delete(v2);
+
+	PASS();
+}
+
+TEST new_small_objsize_zero(void)
+{
+	struct scv_vector *v;
+
+	v = scv_new_small(0, 4);
+
+	ASSERT(v == NULL);
+
+	PASS();
+}
+
+/* scv_mmap_allocator */
+
+TEST mmap_allocator(void)
+{
+	struct scv_mmap_allocator ma;
+	struct scv_vector *v;
+	int i;
+
+	scv_mmap_allocator_init(&ma, 4096);
+
+	v = scv_new_with_allocator(sizeof(int), 16, &ma.allocator);
+
+	ASSERT(v != NULL);
+
+	for (i = 0; i < 100000; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	ASSERT(check_int_vector(v));
+
+	scv_reserve(v, 200000);
+
+	ASSERT(scv_capacity(v) == 200000 && check_int_vector(v));
+
+	scv_shrink_to_fit(v);
+
+	ASSERT(scv_capacity(v) == 100000 && check_int_vector(v));
+
+	scv_resize(v, 10);
+	scv_shrink_to_fit(v);
+
+	ASSERT(scv_size(v) == 10 && check_int_vector(v));
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_delete */
+
+TEST delete_null(void)
+{
+	scv_delete(NULL);
+
+	PASS();
+}
+
+/* scv_init */
+
+TEST init(void)
+{
+	struct scv_vector v;
+	int i;
+	int res;
+
+	res = scv_init(&v, sizeof(int));
+
+	ASSERT(res == SCV_OK && scv_empty(&v) && v.data == NULL);
+
+	for (i = 0; i < 100; ++i) {
+		scv_push_back(&v, &i);
+	}
+
+	ASSERT(check_int_vector(&v));
+
+	scv_destroy(&v);
+
+	ASSERT(v.data == NULL && v.size == 0);
+
+	PASS();
+}
+
+TEST init_objsize_zero(void)
+{
+	struct scv_vector v;
+	int res;
+
+	res = scv_init(&v, 0);
+
+	ASSERT(res != SCV_OK);
+
+	PASS();
+}
+
+TEST init_buffer(void)
+{
+	struct scv_vector v;
+	int buf[8];
+	int i;
+	int res;
+
+	res = scv_init_buffer(&v, sizeof(int), buf, ARRAY_SIZE(buf));
+
+	ASSERT(res == SCV_OK && scv_capacity(&v) == ARRAY_SIZE(buf));
+
+	for (i = 0; i < 8; ++i) {
+		scv_push_back(&v, &i);
+	}
+
+	ASSERT(scv_data(&v) == buf && check_int_vector(&v));
+
+	scv_shrink_to_fit(&v);
+
+	ASSERT(scv_data(&v) == buf);
+
+	for (i = 8; i < 100; ++i) {
+		scv_push_back(&v, &i);
+	}
+
+	ASSERT(scv_data(&v) != buf && check_int_vector(&v));
+
+	scv_destroy(&v);
+
+	PASS();
+}
+
+TEST init_buffer_null(void)
+{
+	struct scv_vector v;
+	int res;
+
+	res = scv_init_buffer(&v, sizeof(int), NULL, 8);
+
+	ASSERT(res == SCV_EINVAL);
+
+	PASS();
+}
+
+TEST destroy_null(void)
+{
+	scv_destroy(NULL);
+
+	PASS();
+}
+
+/* scv_at */
+
+TEST at_inside(void)
+{
+	struct scv_vector *v;
+	int *p;
+
+	v = scv_new(sizeof(int), 25);
+
+	scv_insert(v, 0, NULL, 5);
+
+	p = scv_at(v, 1);
+
+	ASSERT(p != NULL && p == (int *) v->data + 1);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST at_outside(void)
+{
+	struct scv_vector *v;
+	int *p;
+
+	v = scv_new(sizeof(int), 25);
+
+	scv_insert(v, 0, NULL, 5);
+
+	p = scv_at(v, 6);
+
+	ASSERT(p == NULL);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST at_empty(void)
+{
+	struct scv_vector *v;
+	int *p;
+
+	v = scv_new(sizeof(int), 25);
+
+	p = scv_at(v, 0);
+
+	ASSERT(p == NULL);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_front */
+
+TEST front_nonempty(void)
+{
+	struct scv_vector *v;
+	int *p;
+
+	v = scv_new(sizeof(int), 25);
+
+	scv_insert(v, 0, NULL, 5);
+
+	p = scv_front(v);
+
+	ASSERT(p != NULL && p == (int *) v->data);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST front_empty(void)
+{
+	struct scv_vector *v;
+	int *p;
+
+	v = scv_new(sizeof(int), 25);
+
+	p = scv_front(v);
+
+	ASSERT(p == NULL);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_back */
+
+TEST back_nonempty(void)
+{
+	struct scv_vector *v;
+	int *p;
+
+	v = scv_new(sizeof(int), 25);
+
+	scv_insert(v, 0, NULL, 5);
+
+	p = scv_back(v);
+
+	ASSERT(p != NULL && p == (int *) v->data + 4);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST back_single(void)
+{
+	struct scv_vector *v;
+	int *p;
+
+	v = scv_new(sizeof(int), 25);
+
+	scv_insert(v, 0, NULL, 1);
+
+	p = scv_back(v);
+
+	ASSERT(p != NULL && p == (int *) v->data);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST back_empty(void)
+{
+	struct scv_vector *v;
+	int *p;
+
+	v = scv_new(sizeof(int), 25);
+
+	p = scv_back(v);
+
+	ASSERT(p == NULL);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_data */
+
+TEST data_nonempty(void)
+{
+	struct scv_vector *v;
+	int *p;
+
+	v = scv_new(sizeof(int), 25);
+
+	scv_insert(v, 0, NULL, 5);
+
+	p = scv_data(v);
+
+	ASSERT(p != NULL && p == (int *) v->data);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST data_empty(void)
+{
+	struct scv_vector *v;
+	int *p;
+
+	v = scv_new(sizeof(int), 25);
+
+	p = scv_data(v);
+
+	ASSERT(p == NULL);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_empty */
+
+TEST empty_empty(void)
+{
+	struct scv_vector *v;
+	int res;
+
+	v = scv_new(1, 100);
+
+	res = scv_empty(v);
+
+	ASSERT(res != 0);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST empty_nonempty(void)
+{
+	struct scv_vector *v;
+	int res;
+
+	v = scv_new(1, 100);
+
+	scv_resize(v, 1);
+
+	res = scv_empty(v);
+
+	ASSERT(res == 0);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_size */
+
+TEST size_empty(void)
+{
+	struct scv_vector *v;
+
+	v = scv_new(3, 25);
+
+	ASSERT(v != NULL && scv_size(v) == 0);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST size_nonempty(void)
+{
+	struct scv_vector *v;
+
+	v = scv_new(3, 25);
+
+	scv_resize(v, 10);
+
+	ASSERT(v != NULL && scv_size(v) == 10);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_objsize */
+
+TEST objsize(void)
+{
+	struct scv_vector *v;
+
+	v = scv_new(3, 25);
+
+	ASSERT(v != NULL && scv_objsize(v) == 3);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_reserve */
+
+TEST reserve_zero(void)
+{
+	struct scv_vector *v;
+	int res;
+
+	v = scv_new(1, 100);
+
+	res = scv_reserve(v, 0);
+
+	ASSERT(res == SCV_OK && scv_capacity(v) == 100);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST reserve_below_size(void)
+{
+	struct scv_vector *v;
+	int res;
+
+	v = scv_new(1, 120);
+
+	scv_resize(v, 100);
+
+	res = scv_reserve(v, 80);
+
+	ASSERT(res == SCV_OK && scv_size(v) == 100 && scv_capacity(v) == 120);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST reserve_equals_size(void)
+{
+	struct scv_vector *v;
+	int res;
+
+	v = scv_new(1, 120);
+
+	scv_resize(v, 100);
+
+	res = scv_reserve(v, 100);
+
+	ASSERT(res == SCV_OK && scv_size(v) == 100 && scv_capacity(v) == 120);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST reserve_above_size(void)
+{
+	struct scv_vector *v;
+	int res;
+
+	v = scv_new(1, 120);
+
+	scv_resize(v, 100);
+
+	res = scv_reserve(v, 110);
+
+	ASSERT(res == SCV_OK && scv_size(v) == 100 && scv_capacity(v) == 120);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST reserve_above_capacity(void)
+{
+	struct scv_vector *v;
+	int res;
+
+	v = scv_new(1, 120);
+
+	scv_resize(v, 100);
+
+	res = scv_reserve(v, 140);
+
+	ASSERT(res == SCV_OK && scv_size(v) == 100 && scv_capacity(v) == 140);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST reserve_capacity_max(void)
+{
+	struct scv_vector *v;
+	int res;
+
+	v = scv_new(1, 100);
+
+	res = scv_reserve(v, (size_t) -1);
+
+	ASSERT(res != SCV_OK);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_capacity */
+
+TEST capacity(void)
+{
+	struct scv_vector *v;
+
+	v = scv_new(3, 25);
+
+	ASSERT(v != NULL && scv_capacity(v) >= 25);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_set_growth */
+
+static size_t next_capacity_plus_ten(void *ctx, const struct scv_vector *v, size_t capacity)
+{
+	(void) ctx;
+	(void) capacity;
+
+	return scv_capacity(v) + 10;
+}
+
+TEST set_growth_exact(void)
+{
+	static const struct scv_growth exact = { 0, 100, 100, 0, NULL, NULL };
+	struct scv_vector *v;
+	int i;
+	int res;
+
+	v = scv_new(sizeof(int), 1);
+
+	res = scv_set_growth(v, &exact);
+
+	ASSERT(res == SCV_OK);
+
+	scv_shrink_to_fit(v);
+
+	ASSERT(scv_capacity(v) == 1);
+
+	for (i = 0; i < 100; ++i) {
+		scv_push_back(v, &i);
+		ASSERT(scv_capacity(v) == scv_size(v));
+	}
+
+	ASSERT(check_int_vector(v));
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST set_growth_factor(void)
+{
+	static const struct scv_growth quad = { 0, 400, 400, 0, NULL, NULL };
+	struct scv_vector *v;
+	int i = 0;
+
+	v = scv_new(1, 100);
+
+	scv_set_growth(v, &quad);
+	scv_resize(v, 100);
+
+	scv_push_back(v, &i);
+
+	ASSERT(scv_capacity(v) == 401);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST set_growth_callback(void)
+{
+	static const struct scv_growth plus_ten = { 0, 0, 0, 0, next_capacity_plus_ten, NULL };
+	struct scv_vector *v;
+	int i;
+
+	v = scv_new(sizeof(int), 5);
+
+	scv_set_growth(v, &plus_ten);
+	scv_shrink_to_fit(v);
+
+	ASSERT(scv_capacity(v) == 1);
+
+	for (i = 0; i < 12; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	ASSERT(scv_capacity(v) == 21 && check_int_vector(v));
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST set_growth_invalid_factor(void)
+{
+	static const struct scv_growth shrinking = { 0, 50, 200, 0, NULL, NULL };
+	struct scv_vector *v;
+	int res;
+
+	v = scv_new(sizeof(int), 5);
+
+	res = scv_set_growth(v, &shrinking);
+
+	ASSERT(res == SCV_EINVAL && v->ext == NULL);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_set_incremental */
+
+TEST set_incremental(void)
+{
+	struct scv_vector *v;
+	int moving = 0;
+	int i;
+	int j;
+
+	v = scv_new(sizeof(int), 16);
+
+	scv_set_incremental(v, 4);
+
+	for (i = 0; i < 1000; ++i) {
+		scv_push_back(v, &i);
+
+		if (v->flags & SCV_I_MOVING) {
+			moving = 1;
+		}
+
+		for (j = 0; j <= i; ++j) {
+			ASSERT(*(int *) scv_at(v, (size_t) j) == j);
+		}
+
+		ASSERT(*(int *) scv_back(v) == i && *(int *) scv_front(v) == 0);
+	}
+
+	ASSERT(moving);
+
+	ASSERT(check_int_vector(v) && !(v->flags & SCV_I_MOVING));
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST set_incremental_pop_back(void)
+{
+	struct scv_vector *v;
+	int i;
+
+	v = scv_new(sizeof(int), 16);
+
+	scv_set_incremental(v, 2);
+
+	for (i = 0; i < 100 || !(v->flags & SCV_I_MOVING); ++i) {
+		scv_push_back(v, &i);
+	}
+
+	while (v->flags & SCV_I_MOVING) {
+		scv_pop_back(v);
+	}
+
+	ASSERT(!scv_empty(v) && check_int_vector(v));
+
+	for (i = (int) scv_size(v); i < 1000; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	ASSERT(check_int_vector(v));
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST set_incremental_copy(void)
+{
+	struct scv_vector *v1;
+	struct scv_vector *v2;
+	int i;
+
+	v1 = scv_new(sizeof(int), 16);
+	v2 = scv_new(sizeof(int), 16);
+
+	scv_set_incremental(v1, 1);
+
+	for (i = 0; i < 100 || !(v1->flags & SCV_I_MOVING); ++i) {
+		scv_push_back(v1, &i);
+	}
+
+	scv_copy(v2, v1);
+
+	ASSERT((v1->flags & SCV_I_MOVING) && check_int_vector(v2));
+
+	scv_insert(v1, 0, NULL, 0);
+
+	ASSERT(!(v1->flags & SCV_I_MOVING) && check_int_vector(v1));
+
+	scv_delete(v1);
+	scv_delete(v2);
+
+	PASS();
+}
+
+TEST set_incremental_alloc_fail(void)
+{
+	struct count_allocator ca = { 0, 0, 0, 0, 0 };
+	struct scv_allocator a;
+	struct scv_vector *v;
+	int i;
+
+	a.allocate = count_allocate;
+	a.reallocate = count_reallocate;
+	a.deallocate = count_deallocate;
+	a.ctx = &ca;
+
+	v = scv_new_with_allocator(sizeof(int), 16, &a);
+
+	ASSERT(v != NULL && scv_set_incremental(v, 2) == SCV_OK);
+
+	for (i = 0; i < 16; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	ASSERT(scv_capacity(v) == 16 && ca.nrealloc == 0);
+
+	/* The new memory cannot be allocated, so the block is reallocated
+	 * and all elements moved at once */
+	ca.limit = 16 * sizeof(int);
+
+	ASSERT(scv_push_back(v, &i) == SCV_OK);
+	ASSERT(!(v->flags & SCV_I_MOVING) && scv_capacity(v) > 17);
+	ASSERT(ca.nrealloc == 1 && check_int_vector(v));
+
+	ca.limit = 0;
+
+	for (i = 17; i < 1000; ++i) {
+		ASSERT(scv_push_back(v, &i) == SCV_OK);
+	}
+
+	ASSERT(check_int_vector(v));
+
+	scv_delete(v);
+
+	ASSERT(ca.nfree == ca.nalloc && ca.bytes == 0);
+
+	PASS();
+}
+
+/* scv_shrink_to_fit */
+
+TEST shrink_to_fit_empty(void)
+{
+	struct scv_vector *v;
+	int res;
+
+	v = scv_new(1, 100);
+
+	res = scv_shrink_to_fit(v);
+
+	ASSERT(res == SCV_OK && scv_capacity(v) > 0);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST shrink_to_fit_size_equals_capacity(void)
+{
+	struct scv_vector *v;
+	int res;
+
+	v = scv_new(1, 100);
+
+	scv_resize(v, 100);
+
+	res = scv_shrink_to_fit(v);
+
+	ASSERT(res == SCV_OK && scv_size(v) == scv_capacity(v));
 
-	ASSERT(v == NULL);
+	scv_delete(v);
 
 	PASS();
 }
 
-TEST new_capacity_zero(void)
+TEST shrink_to_fit_size_below_capacity(void)
 {
 	struct scv_vector *v;
+	int res;
 
-	v = scv_new(1, 0);
+	v = scv_new(1, 100);
 
-	ASSERT(v != NULL);
+	scv_resize(v, 80);
+
+	res = scv_shrink_to_fit(v);
+
+	ASSERT(res == SCV_OK && scv_size(v) == scv_capacity(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST new_objsize_max(void)
+/* scv_clear */
+
+TEST clear_nonempty(void)
 {
 	struct scv_vector *v;
+	int res;
 
-	v = scv_new((size_t) -1, 0);
+	v = scv_new(sizeof(int), 25);
 
-	ASSERT(v == NULL);
+	scv_insert(v, 0, NULL, 5);
+
+	res = scv_clear(v);
+
+	ASSERT(res == SCV_OK && scv_size(v) == 0 && scv_capacity(v) == 25);
+
+	scv_delete(v);
 
 	PASS();
 }
 
-TEST new_capacity_max(void)
+TEST clear_empty(void)
 {
 	struct scv_vector *v;
+	int res;
 
-	v = scv_new(1, (size_t) -1);
+	v = scv_new(sizeof(int), 25);
 
-	ASSERT(v == NULL);
+	res = scv_clear(v);
+
+	ASSERT(res == SCV_OK && scv_size(v) == 0 && scv_capacity(v) == 25);
+
+	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_delete */
+/* scv_assign */
 
-TEST delete_null(void)
+TEST assign_empty_and_nonempty(void)
 {
-	scv_delete(NULL);
+	struct scv_vector *v;
+	const int data[] = { 0, 1, 2, 3, 4 };
+	int res;
+
+	v = scv_new(sizeof(int), 25);
+
+	ASSERT(scv_size(v) == 0);
+
+	res = scv_assign(v, NULL, 0);
+
+	ASSERT(res == SCV_OK && scv_capacity(v) == 25 && scv_size(v) == 0);
+
+	res = scv_assign(v, data, ARRAY_SIZE(data));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	ASSERT(check_int_vector(v));
+
+	res = scv_assign(v, NULL, 0);
+
+	ASSERT(res == SCV_OK && scv_size(v) == 0);
+
+	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_at */
-
-TEST at_inside(void)
+TEST assign_less(void)
 {
 	struct scv_vector *v;
-	int *p;
+	const int data1[] = { -1, -1, -1, -1, -1, -1, -1 };
+	const int data2[] = { 0, 1, 2, 3, 4 };
+	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	scv_insert(v, 0, NULL, 5);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	p = scv_at(v, 1);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
 
-	ASSERT(p != NULL && p == (int *) v->data + 1);
+	res = scv_assign(v, data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data2));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST at_outside(void)
+TEST assign_more(void)
 {
 	struct scv_vector *v;
-	int *p;
+	const int data1[] = { -1, -1, -1 };
+	const int data2[] = { 0, 1, 2, 3, 4 };
+	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	scv_insert(v, 0, NULL, 5);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	p = scv_at(v, 6);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
 
-	ASSERT(p == NULL);
+	res = scv_assign(v, data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data2));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST at_empty(void)
+TEST assign_null_data(void)
 {
 	struct scv_vector *v;
-	int *p;
+	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	p = scv_at(v, 0);
+	ASSERT(scv_size(v) == 0);
 
-	ASSERT(p == NULL);
+	res = scv_assign(v, NULL, 50);
+
+	ASSERT(res == SCV_OK && scv_size(v) == 50);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_front */
-
-TEST front_nonempty(void)
+TEST assign_growing_capacity(void)
 {
 	struct scv_vector *v;
-	int *p;
+	const int data1[] = { -1, -1, -1 };
+	int data2[50];
+	int res;
+	size_t i;
+
+	for (i = 0; i < ARRAY_SIZE(data2); ++i) {
+		data2[i] = (int) i;
+	}
 
 	v = scv_new(sizeof(int), 25);
 
-	scv_insert(v, 0, NULL, 5);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	p = scv_front(v);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(scv_capacity(v) == 25);
 
-	ASSERT(p != NULL && p == (int *) v->data);
+	res = scv_assign(v, data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data2));
+	ASSERT(scv_capacity(v) >= ARRAY_SIZE(data2));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST front_empty(void)
+TEST assign_nobj_max(void)
 {
 	struct scv_vector *v;
-	int *p;
+	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	p = scv_front(v);
+	res = scv_assign(v, NULL, (size_t) -1);
 
-	ASSERT(p == NULL);
+	ASSERT(res != SCV_OK && scv_size(v) == 0);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_back */
+/* scv_replace */
 
-TEST back_nonempty(void)
+TEST replace_empty_vector(void)
 {
 	struct scv_vector *v;
-	int *p;
+	const int data[] = { 0, 1, 2, 3, 4 };
+	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	scv_insert(v, 0, NULL, 5);
-
-	p = scv_back(v);
+	res = scv_replace(v, 0, 0, data, ARRAY_SIZE(data));
 
-	ASSERT(p != NULL && p == (int *) v->data + 4);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST back_single(void)
+TEST replace_empty_range_start(void)
 {
 	struct scv_vector *v;
-	int *p;
+	const int data1[] = { 2, 3, 4 };
+	const int data2[] = { 0, 1 };
+	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	scv_insert(v, 0, NULL, 1);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	p = scv_back(v);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
 
-	ASSERT(p != NULL && p == (int *) v->data);
+	res = scv_replace(v, 0, 0, data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST back_empty(void)
+TEST replace_empty_range_middle(void)
 {
 	struct scv_vector *v;
-	int *p;
+	const int data1[] = { 0, 1, 4 };
+	const int data2[] = { 2, 3 };
+	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	p = scv_back(v);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	ASSERT(p == NULL);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+
+	res = scv_replace(v, 2, 2, data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_data */
-
-TEST data_nonempty(void)
+TEST replace_empty_range_end(void)
 {
 	struct scv_vector *v;
-	int *p;
+	const int data1[] = { 0, 1, 2 };
+	const int data2[] = { 3, 4 };
+	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	scv_insert(v, 0, NULL, 5);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	p = scv_data(v);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
 
-	ASSERT(p != NULL && p == (int *) v->data);
+	res = scv_replace(v, 3, 3, data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST data_empty(void)
+TEST replace_start(void)
 {
 	struct scv_vector *v;
-	int *p;
+	const int data1[] = { -1, -1, 2, 3, 4 };
+	const int data2[] = { 0, 1 };
+	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	p = scv_data(v);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	ASSERT(p == NULL);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+
+	res = scv_replace(v, 0, 2, data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_empty */
+TEST replace_middle(void)
+{
+	struct scv_vector *v;
+	const int data1[] = { 0, 1, -1, -1, 4 };
+	const int data2[] = { 2, 3 };
+	int res;
 
-TEST empty_empty(void)
+	v = scv_new(sizeof(int), 25);
+
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+
+	res = scv_replace(v, 2, 4, data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(check_int_vector(v));
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST replace_end(void)
 {
 	struct scv_vector *v;
+	const int data1[] = { 0, 1, 2, -1, -1 };
+	const int data2[] = { 3, 4 };
 	int res;
 
-	v = scv_new(1, 100);
+	v = scv_new(sizeof(int), 25);
 
-	res = scv_empty(v);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	ASSERT(res != 0);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+
+	res = scv_replace(v, 3, scv_size(v), data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST empty_nonempty(void)
+TEST replace_start_with_nothing(void)
 {
 	struct scv_vector *v;
+	const int data[] = { -1, -1, 0, 1, 2, 3, 4 };
 	int res;
 
-	v = scv_new(1, 100);
+	v = scv_new(sizeof(int), 25);
 
-	scv_resize(v, 1);
+	res = scv_assign(v, data, ARRAY_SIZE(data));
 
-	res = scv_empty(v);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	ASSERT(res == 0);
+	res = scv_replace(v, 0, 2, NULL, 0);
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 2);
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_size */
-
-TEST size_empty(void)
+TEST replace_middle_with_nothing(void)
 {
 	struct scv_vector *v;
+	const int data[] = { 0, 1, -1, -1, 2, 3, 4 };
+	int res;
 
-	v = scv_new(3, 25);
-
-	ASSERT(v != NULL && scv_size(v) == 0);
-
-	scv_delete(v);
-
-	PASS();
-}
+	v = scv_new(sizeof(int), 25);
 
-TEST size_nonempty(void)
-{
-	struct scv_vector *v;
+	res = scv_assign(v, data, ARRAY_SIZE(data));
 
-	v = scv_new(3, 25);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	scv_resize(v, 10);
+	res = scv_replace(v, 2, 4, NULL, 0);
 
-	ASSERT(v != NULL && scv_size(v) == 10);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 2);
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_objsize */
-
-TEST objsize(void)
+TEST replace_end_with_nothing(void)
 {
 	struct scv_vector *v;
+	const int data[] = { 0, 1, 2, 3, 4, -1, -1 };
+	int res;
 
-	v = scv_new(3, 25);
+	v = scv_new(sizeof(int), 25);
 
-	ASSERT(v != NULL && scv_objsize(v) == 3);
+	res = scv_assign(v, data, ARRAY_SIZE(data));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+
+	res = scv_replace(v, scv_size(v) - 2, scv_size(v), NULL, 0);
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 2);
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_reserve */
-
-TEST reserve_zero(void)
+TEST replace_with_less(void)
 {
 	struct scv_vector *v;
+	const int data1[] = { 0, 1, -1, -1, -1, 4 };
+	const int data2[] = { 2, 3 };
 	int res;
 
-	v = scv_new(1, 100);
+	v = scv_new(sizeof(int), 25);
 
-	res = scv_reserve(v, 0);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	ASSERT(res == SCV_OK && scv_capacity(v) == 100);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+
+	res = scv_replace(v, 2, 5, data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == 5);
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST reserve_below_size(void)
+TEST replace_with_more(void)
 {
 	struct scv_vector *v;
+	const int data1[] = { 0, 1, -1, 4 };
+	const int data2[] = { 2, 3 };
 	int res;
 
-	v = scv_new(1, 120);
+	v = scv_new(sizeof(int), 25);
 
-	scv_resize(v, 100);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	res = scv_reserve(v, 80);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
 
-	ASSERT(res == SCV_OK && scv_size(v) == 100 && scv_capacity(v) == 120);
+	res = scv_replace(v, 2, 3, data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == 5);
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST reserve_equals_size(void)
+TEST replace_all_with_less(void)
 {
 	struct scv_vector *v;
+	const int data1[] = { -1, -1, -1, -1, -1, -1, -1 };
+	const int data2[] = { 0, 1, 2, 3, 4 };
 	int res;
 
-	v = scv_new(1, 120);
+	v = scv_new(sizeof(int), 25);
 
-	scv_resize(v, 100);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	res = scv_reserve(v, 100);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
 
-	ASSERT(res == SCV_OK && scv_size(v) == 100 && scv_capacity(v) == 120);
+	res = scv_replace(v, 0, scv_size(v), data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data2));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST reserve_above_size(void)
+TEST replace_all_with_more(void)
 {
 	struct scv_vector *v;
+	const int data1[] = { -1, -1, -1 };
+	const int data2[] = { 0, 1, 2, 3, 4 };
 	int res;
 
-	v = scv_new(1, 120);
+	v = scv_new(sizeof(int), 25);
 
-	scv_resize(v, 100);
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-	res = scv_reserve(v, 110);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
 
-	ASSERT(res == SCV_OK && scv_size(v) == 100 && scv_capacity(v) == 120);
+	res = scv_replace(v, 0, scv_size(v), data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data2));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST reserve_above_capacity(void)
+TEST replace_with_null_data(void)
 {
 	struct scv_vector *v;
+	const int data[] = { -1, -1, -1 };
 	int res;
 
-	v = scv_new(1, 120);
+	v = scv_new(sizeof(int), 25);
 
-	scv_resize(v, 100);
+	res = scv_assign(v, data, ARRAY_SIZE(data));
 
-	res = scv_reserve(v, 140);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == 100 && scv_capacity(v) == 140);
+	res = scv_replace(v, 0, scv_size(v), NULL, 50);
+
+	ASSERT(res == SCV_OK && scv_size(v) == 50);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST reserve_capacity_max(void)
+TEST replace_growing_capacity(void)
 {
 	struct scv_vector *v;
+	const int data1[] = { 45, 46, 47, 48, 49 };
+	int data2[45];
 	int res;
+	size_t i;
 
-	v = scv_new(1, 100);
-
-	res = scv_reserve(v, (size_t) -1);
-
-	ASSERT(res != SCV_OK);
-
-	scv_delete(v);
+	for (i = 0; i < ARRAY_SIZE(data2); ++i) {
+		data2[i] = (int) i;
+	}
 
-	PASS();
-}
+	v = scv_new(sizeof(int), 25);
 
-/* scv_capacity */
+	res = scv_assign(v, data1, ARRAY_SIZE(data1));
 
-TEST capacity(void)
-{
-	struct scv_vector *v;
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
 
-	v = scv_new(3, 25);
+	res = scv_replace(v, 0, 0, data2, ARRAY_SIZE(data2));
 
-	ASSERT(v != NULL && scv_capacity(v) >= 25);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_shrink_to_fit */
-
-TEST shrink_to_fit_empty(void)
+TEST replace_nobj_max(void)
 {
 	struct scv_vector *v;
 	int res;
 
-	v = scv_new(1, 100);
+	v = scv_new(sizeof(int), 25);
 
-	res = scv_shrink_to_fit(v);
+	res = scv_replace(v, 0, 0, NULL, (size_t) -1);
 
-	ASSERT(res == SCV_OK && scv_capacity(v) > 0);
+	ASSERT(res != SCV_OK && scv_size(v) == 0);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST shrink_to_fit_size_equals_capacity(void)
+TEST replace_outside_range(void)
 {
 	struct scv_vector *v;
+	const int data[] = { 0, 1, 2, 3, 4 };
 	int res;
 
-	v = scv_new(1, 100);
+	v = scv_new(sizeof(int), 25);
 
-	scv_resize(v, 100);
+	res = scv_assign(v, data, ARRAY_SIZE(data));
 
-	res = scv_shrink_to_fit(v);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == scv_capacity(v));
+	res = scv_replace(v, 2, scv_size(v) + 1, NULL, 0);
+
+	ASSERT(res != SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST shrink_to_fit_size_below_capacity(void)
+TEST replace_negative_range(void)
 {
 	struct scv_vector *v;
+	const int data[] = { 0, 1, 2, 3, 4 };
 	int res;
 
-	v = scv_new(1, 100);
+	v = scv_new(sizeof(int), 25);
 
-	scv_resize(v, 80);
+	res = scv_assign(v, data, ARRAY_SIZE(data));
 
-	res = scv_shrink_to_fit(v);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == scv_capacity(v));
+	res = scv_replace(v, 3, 2, NULL, 1);
+
+	ASSERT(res != SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_clear */
+/* scv_insert */
 
-TEST clear_nonempty(void)
+TEST insert_empty_vector(void)
 {
 	struct scv_vector *v;
+	const int data[] = { 0, 1, 2, 3, 4 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	scv_insert(v, 0, NULL, 5);
-
-	res = scv_clear(v);
+	res = scv_insert(v, 0, data, ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == 0 && scv_capacity(v) == 25);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST clear_empty(void)
+TEST insert_start(void)
 {
 	struct scv_vector *v;
+	const int data1[] = { 2, 3, 4 };
+	const int data2[] = { 0, 1 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_clear(v);
+	res = scv_insert(v, 0, data1, ARRAY_SIZE(data1));
 
-	ASSERT(res == SCV_OK && scv_size(v) == 0 && scv_capacity(v) == 25);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+
+	res = scv_insert(v, 0, data2, ARRAY_SIZE(data2));
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_assign */
-
-TEST assign_empty_and_nonempty(void)
+TEST insert_middle(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, 2, 3, 4 };
+	const int data1[] = { 0, 1, 4 };
+	const int data2[] = { 2, 3 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	ASSERT(scv_size(v) == 0);
-
-	res = scv_assign(v, NULL, 0);
+	res = scv_insert(v, 0, data1, ARRAY_SIZE(data1));
 
-	ASSERT(res == SCV_OK && scv_capacity(v) == 25 && scv_size(v) == 0);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
 
-	res = scv_assign(v, data, ARRAY_SIZE(data));
+	res = scv_insert(v, 2, data2, ARRAY_SIZE(data2));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
 	ASSERT(check_int_vector(v));
 
-	res = scv_assign(v, NULL, 0);
-
-	ASSERT(res == SCV_OK && scv_size(v) == 0);
-
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST assign_less(void)
+TEST insert_end(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { -1, -1, -1, -1, -1, -1, -1 };
-	const int data2[] = { 0, 1, 2, 3, 4 };
+	const int data1[] = { 0, 1, 2 };
+	const int data2[] = { 3, 4 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	res = scv_insert(v, 0, data1, ARRAY_SIZE(data1));
 
 	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
 
-	res = scv_assign(v, data2, ARRAY_SIZE(data2));
+	res = scv_insert(v, scv_size(v), data2, ARRAY_SIZE(data2));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data2));
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
 	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
@@ -638,22 +2060,31 @@ TEST assign_less(void)
 	PASS();
 }
 
-TEST assign_more(void)
+TEST insert_nothing(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { -1, -1, -1 };
-	const int data2[] = { 0, 1, 2, 3, 4 };
+	const int data[] = { 0, 1, 2, 3, 4 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	res = scv_insert(v, 0, data, ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	res = scv_assign(v, data2, ARRAY_SIZE(data2));
+	res = scv_insert(v, 0, NULL, 0);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data2));
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	ASSERT(check_int_vector(v));
+
+	res = scv_insert(v, 2, NULL, 0);
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	ASSERT(check_int_vector(v));
+
+	res = scv_insert(v, scv_size(v), NULL, 0);
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
@@ -661,29 +2092,32 @@ TEST assign_more(void)
 	PASS();
 }
 
-TEST assign_null_data(void)
+TEST insert_null_data(void)
 {
 	struct scv_vector *v;
+	const int data[] = { -1, -1, -1 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	ASSERT(scv_size(v) == 0);
+	res = scv_insert(v, 0, data, ARRAY_SIZE(data));
 
-	res = scv_assign(v, NULL, 50);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == 50);
+	res = scv_insert(v, 0, NULL, 50);
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) + 50);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST assign_growing_capacity(void)
+TEST insert_growing_capacity(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { -1, -1, -1 };
-	int data2[50];
+	const int data1[] = { 45, 46, 47, 48, 49 };
+	int data2[45];
 	int res;
 	size_t i;
 
@@ -693,15 +2127,13 @@ TEST assign_growing_capacity(void)
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	res = scv_insert(v, 0, data1, ARRAY_SIZE(data1));
 
 	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
-	ASSERT(scv_capacity(v) == 25);
 
-	res = scv_assign(v, data2, ARRAY_SIZE(data2));
+	res = scv_insert(v, 0, data2, ARRAY_SIZE(data2));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data2));
-	ASSERT(scv_capacity(v) >= ARRAY_SIZE(data2));
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
 	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
@@ -709,14 +2141,14 @@ TEST assign_growing_capacity(void)
 	PASS();
 }
 
-TEST assign_nobj_max(void)
+TEST insert_nobj_max(void)
 {
 	struct scv_vector *v;
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_assign(v, NULL, (size_t) -1);
+	res = scv_insert(v, 0, NULL, (size_t) -1);
 
 	ASSERT(res != SCV_OK && scv_size(v) == 0);
 
@@ -725,9 +2157,7 @@ TEST assign_nobj_max(void)
 	PASS();
 }
 
-/* scv_replace */
-
-TEST replace_empty_vector(void)
+TEST insert_outside_range(void)
 {
 	struct scv_vector *v;
 	const int data[] = { 0, 1, 2, 3, 4 };
@@ -735,9 +2165,13 @@ TEST replace_empty_vector(void)
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_replace(v, 0, 0, data, ARRAY_SIZE(data));
+	res = scv_insert(v, 0, data, ARRAY_SIZE(data));
 
 	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+
+	res = scv_insert(v, scv_size(v) + 1, NULL, 0);
+
+	ASSERT(res != SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
@@ -745,137 +2179,126 @@ TEST replace_empty_vector(void)
 	PASS();
 }
 
-TEST replace_empty_range_start(void)
+/* scv_insert_batch */
+
+TEST insert_batch(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { 2, 3, 4 };
-	const int data2[] = { 0, 1 };
+	const int data[] = { 1, 3, 4, 7, 9, 10 };
+	const int ins[] = { 0, 2, 5, 6, 8, 11 };
+	const size_t pos[] = { 0, 1, 3, 3, 4, 6 };
 	int res;
 
-	v = scv_new(sizeof(int), 25);
-
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	v = scv_new(sizeof(int), 0);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	scv_assign(v, data, ARRAY_SIZE(data));
 
-	res = scv_replace(v, 0, 0, data2, ARRAY_SIZE(data2));
+	res = scv_insert_batch(v, pos, ins, ARRAY_SIZE(ins));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
-	ASSERT(check_int_vector(v));
+	ASSERT(res == SCV_OK && scv_size(v) == 12 && check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_empty_range_middle(void)
+TEST insert_batch_empty_vector(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { 0, 1, 4 };
-	const int data2[] = { 2, 3 };
+	const int ins[] = { 0, 1, 2 };
+	const size_t pos[] = { 0, 0, 0 };
 	int res;
 
-	v = scv_new(sizeof(int), 25);
-
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
-
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	v = scv_new(sizeof(int), 0);
 
-	res = scv_replace(v, 2, 2, data2, ARRAY_SIZE(data2));
+	res = scv_insert_batch(v, pos, ins, ARRAY_SIZE(ins));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
-	ASSERT(check_int_vector(v));
+	ASSERT(res == SCV_OK && scv_size(v) == 3 && check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_empty_range_end(void)
+TEST insert_batch_outside_range(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { 0, 1, 2 };
-	const int data2[] = { 3, 4 };
+	const int ins[] = { 0, 1 };
+	const size_t pos[] = { 0, 6 };
 	int res;
 
-	v = scv_new(sizeof(int), 25);
-
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	v = scv_new(sizeof(int), 0);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	scv_resize(v, 5);
 
-	res = scv_replace(v, 3, 3, data2, ARRAY_SIZE(data2));
+	res = scv_insert_batch(v, pos, ins, ARRAY_SIZE(ins));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
-	ASSERT(check_int_vector(v));
+	ASSERT(res == SCV_ERANGE && scv_size(v) == 5);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_start(void)
+TEST insert_batch_unsorted(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { -1, -1, 2, 3, 4 };
-	const int data2[] = { 0, 1 };
+	const int ins[] = { 0, 1 };
+	const size_t pos[] = { 3, 2 };
 	int res;
 
-	v = scv_new(sizeof(int), 25);
-
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	v = scv_new(sizeof(int), 0);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	scv_resize(v, 5);
 
-	res = scv_replace(v, 0, 2, data2, ARRAY_SIZE(data2));
+	res = scv_insert_batch(v, pos, ins, ARRAY_SIZE(ins));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
-	ASSERT(check_int_vector(v));
+	ASSERT(res == SCV_EINVAL && scv_size(v) == 5);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_middle(void)
+/* scv_erase */
+
+TEST erase_nothing(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { 0, 1, -1, -1, 4 };
-	const int data2[] = { 2, 3 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	res = scv_erase(v, 0, 0);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(res == SCV_OK && scv_size(v) == 0);
 
-	res = scv_replace(v, 2, 4, data2, ARRAY_SIZE(data2));
+	scv_resize(v, 10);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
-	ASSERT(check_int_vector(v));
+	res = scv_erase(v, 0, 0);
+
+	ASSERT(res == SCV_OK && scv_size(v) == 10);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_end(void)
+TEST erase_start(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { 0, 1, 2, -1, -1 };
-	const int data2[] = { 3, 4 };
+	const int data[] = { -1, -1, 0, 1, 2, 3, 4 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	res = scv_assign(v, data, ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	res = scv_replace(v, 3, scv_size(v), data2, ARRAY_SIZE(data2));
+	res = scv_erase(v, 0, 2);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 2);
 	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
@@ -883,10 +2306,10 @@ TEST replace_end(void)
 	PASS();
 }
 
-TEST replace_start_with_nothing(void)
+TEST erase_middle(void)
 {
 	struct scv_vector *v;
-	const int data[] = { -1, -1, 0, 1, 2, 3, 4 };
+	const int data[] = { 0, 1, -1, -1, 2, 3, 4 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
@@ -895,7 +2318,7 @@ TEST replace_start_with_nothing(void)
 
 	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	res = scv_replace(v, 0, 2, NULL, 0);
+	res = scv_erase(v, 2, 4);
 
 	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 2);
 	ASSERT(check_int_vector(v));
@@ -905,10 +2328,10 @@ TEST replace_start_with_nothing(void)
 	PASS();
 }
 
-TEST replace_middle_with_nothing(void)
+TEST erase_end(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, -1, -1, 2, 3, 4 };
+	const int data[] = { 0, 1, 2, 3, 4, -1, -1 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
@@ -917,7 +2340,7 @@ TEST replace_middle_with_nothing(void)
 
 	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	res = scv_replace(v, 2, 4, NULL, 0);
+	res = scv_erase(v, scv_size(v) - 2, scv_size(v));
 
 	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 2);
 	ASSERT(check_int_vector(v));
@@ -927,10 +2350,10 @@ TEST replace_middle_with_nothing(void)
 	PASS();
 }
 
-TEST replace_end_with_nothing(void)
+TEST erase_all(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, 2, 3, 4, -1, -1 };
+	const int data[] = { 0, 1, 2, 3, 4 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
@@ -939,32 +2362,30 @@ TEST replace_end_with_nothing(void)
 
 	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	res = scv_replace(v, scv_size(v) - 2, scv_size(v), NULL, 0);
+	res = scv_erase(v, 0, scv_size(v));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 2);
-	ASSERT(check_int_vector(v));
+	ASSERT(res == SCV_OK && scv_size(v) == 0);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_with_less(void)
+TEST erase_outside_range(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { 0, 1, -1, -1, -1, 4 };
-	const int data2[] = { 2, 3 };
+	const int data[] = { 0, 1, 2, 3, 4 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	res = scv_assign(v, data, ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	res = scv_replace(v, 2, 5, data2, ARRAY_SIZE(data2));
+	res = scv_erase(v, 2, scv_size(v) + 1);
 
-	ASSERT(res == SCV_OK && scv_size(v) == 5);
+	ASSERT(res != SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
@@ -972,22 +2393,21 @@ TEST replace_with_less(void)
 	PASS();
 }
 
-TEST replace_with_more(void)
+TEST erase_negative_range(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { 0, 1, -1, 4 };
-	const int data2[] = { 2, 3 };
+	const int data[] = { 0, 1, 2, 3, 4 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	res = scv_assign(v, data, ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	res = scv_replace(v, 2, 3, data2, ARRAY_SIZE(data2));
+	res = scv_erase(v, 3, 2);
 
-	ASSERT(res == SCV_OK && scv_size(v) == 5);
+	ASSERT(res != SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
@@ -995,243 +2415,305 @@ TEST replace_with_more(void)
 	PASS();
 }
 
-TEST replace_all_with_less(void)
+/* scv_erase_if */
+
+static int is_odd(const void *elem, void *ctx)
+{
+	(void) ctx;
+
+	return *(const int *) elem & 1;
+}
+
+static int is_multiple(const void *elem, void *ctx)
+{
+	return *(const int *) elem % *(int *) ctx == 0;
+}
+
+TEST erase_if(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { -1, -1, -1, -1, -1, -1, -1 };
-	const int data2[] = { 0, 1, 2, 3, 4 };
+	int *p;
+	int i;
 	int res;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new(sizeof(int), 0);
 
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	for (i = 0; i < 100; ++i) {
+		scv_push_back(v, &i);
+	}
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	res = scv_erase_if(v, is_odd, NULL);
 
-	res = scv_replace(v, 0, scv_size(v), data2, ARRAY_SIZE(data2));
+	ASSERT(res == SCV_OK && scv_size(v) == 50);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data2));
-	ASSERT(check_int_vector(v));
+	p = scv_data(v);
+
+	for (i = 0; i < 50; ++i) {
+		ASSERT(p[i] == 2 * i);
+	}
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_all_with_more(void)
+TEST erase_if_all_and_none(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { -1, -1, -1 };
-	const int data2[] = { 0, 1, 2, 3, 4 };
+	const int data[] = { 0, 1, 2, 3, 4 };
+	int m = 7;
 	int res;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new(sizeof(int), 0);
 
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	scv_assign(v, data, ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	res = scv_erase_if(v, is_multiple, &m);
 
-	res = scv_replace(v, 0, scv_size(v), data2, ARRAY_SIZE(data2));
+	ASSERT(res == SCV_OK && scv_size(v) == 4 && *(int *) scv_front(v) == 1);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data2));
-	ASSERT(check_int_vector(v));
+	m = 1;
+
+	res = scv_erase_if(v, is_multiple, &m);
+
+	ASSERT(res == SCV_OK && scv_empty(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_with_null_data(void)
+/*
+ * Erase the first `ctx[0]` odd elements, counting calls in `ctx[1]`.
+ */
+static int first_odd(const void *elem, void *ctx)
+{
+	int *state = (int *) ctx;
+
+	state[1] += 1;
+
+	if (state[0] > 0 && (*(const int *) elem & 1)) {
+		state[0] -= 1;
+		return 1;
+	}
+
+	return 0;
+}
+
+TEST erase_if_pred_calls(void)
 {
 	struct scv_vector *v;
-	const int data[] = { -1, -1, -1 };
+	int state[2];
+	int *p;
+	int i;
 	int res;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new(sizeof(int), 0);
 
-	res = scv_assign(v, data, ARRAY_SIZE(data));
+	for (i = 0; i < 10; ++i) {
+		scv_push_back(v, &i);
+	}
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	state[0] = 3;
+	state[1] = 0;
 
-	res = scv_replace(v, 0, scv_size(v), NULL, 50);
+	res = scv_erase_if(v, first_odd, state);
 
-	ASSERT(res == SCV_OK && scv_size(v) == 50);
+	ASSERT(res == SCV_OK && scv_size(v) == 7);
+	ASSERT_EQ(state[1], 10);
+
+	p = scv_data(v);
+
+	ASSERT(p[0] == 0 && p[1] == 2 && p[2] == 4 && p[3] == 6);
+	ASSERT(p[4] == 7 && p[5] == 8 && p[6] == 9);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_growing_capacity(void)
+/* scv_erase_indices */
+
+TEST erase_indices(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { 45, 46, 47, 48, 49 };
-	int data2[45];
+	const size_t idx[] = { 0, 3, 4, 8, 9 };
+	const int expected[] = { 1, 2, 5, 6, 7 };
+	int *p;
+	int i;
 	int res;
-	size_t i;
 
-	for (i = 0; i < ARRAY_SIZE(data2); ++i) {
-		data2[i] = (int) i;
-	}
+	v = scv_new(sizeof(int), 0);
 
-	v = scv_new(sizeof(int), 25);
+	for (i = 0; i < 10; ++i) {
+		scv_push_back(v, &i);
+	}
 
-	res = scv_assign(v, data1, ARRAY_SIZE(data1));
+	res = scv_erase_indices(v, idx, ARRAY_SIZE(idx));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(expected));
 
-	res = scv_replace(v, 0, 0, data2, ARRAY_SIZE(data2));
+	p = scv_data(v);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
-	ASSERT(check_int_vector(v));
+	for (i = 0; i < (int) ARRAY_SIZE(expected); ++i) {
+		ASSERT(p[i] == expected[i]);
+	}
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_nobj_max(void)
+TEST erase_indices_outside_range(void)
 {
 	struct scv_vector *v;
+	const size_t idx[] = { 1, 5 };
 	int res;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new(sizeof(int), 0);
 
-	res = scv_replace(v, 0, 0, NULL, (size_t) -1);
+	scv_resize(v, 5);
 
-	ASSERT(res != SCV_OK && scv_size(v) == 0);
+	res = scv_erase_indices(v, idx, ARRAY_SIZE(idx));
+
+	ASSERT(res == SCV_ERANGE && scv_size(v) == 5);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_outside_range(void)
+TEST erase_indices_unsorted(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, 2, 3, 4 };
+	const size_t idx[] = { 3, 1 };
+	const size_t dup[] = { 1, 1 };
 	int res;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new(sizeof(int), 0);
 
-	res = scv_assign(v, data, ARRAY_SIZE(data));
+	scv_resize(v, 5);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	res = scv_erase_indices(v, idx, ARRAY_SIZE(idx));
 
-	res = scv_replace(v, 2, scv_size(v) + 1, NULL, 0);
+	ASSERT(res == SCV_EINVAL && scv_size(v) == 5);
 
-	ASSERT(res != SCV_OK && scv_size(v) == ARRAY_SIZE(data));
-	ASSERT(check_int_vector(v));
+	res = scv_erase_indices(v, dup, ARRAY_SIZE(dup));
+
+	ASSERT(res == SCV_EINVAL && scv_size(v) == 5);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST replace_negative_range(void)
+/* scv_swap_remove */
+
+TEST swap_remove(void)
 {
 	struct scv_vector *v;
 	const int data[] = { 0, 1, 2, 3, 4 };
+	int *p;
 	int res;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new(sizeof(int), 0);
 
-	res = scv_assign(v, data, ARRAY_SIZE(data));
+	scv_assign(v, data, ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	res = scv_swap_remove(v, 1);
 
-	res = scv_replace(v, 3, 2, NULL, 1);
+	p = scv_data(v);
 
-	ASSERT(res != SCV_OK && scv_size(v) == ARRAY_SIZE(data));
-	ASSERT(check_int_vector(v));
+	ASSERT(res == SCV_OK && scv_size(v) == 4);
+	ASSERT(p[0] == 0 && p[1] == 4 && p[2] == 2 && p[3] == 3);
+
+	res = scv_swap_remove(v, 3);
+
+	ASSERT(res == SCV_OK && scv_size(v) == 3 && p[2] == 2);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_insert */
-
-TEST insert_empty_vector(void)
+TEST swap_remove_outside_range(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, 2, 3, 4 };
 	int res;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new(sizeof(int), 0);
 
-	res = scv_insert(v, 0, data, ARRAY_SIZE(data));
+	res = scv_swap_remove(v, 0);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
-	ASSERT(check_int_vector(v));
+	ASSERT(res == SCV_ERANGE);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST insert_start(void)
+TEST swap_remove_indices(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { 2, 3, 4 };
-	const int data2[] = { 0, 1 };
+	const size_t idx[] = { 0, 2, 7, 8, 9 };
+	int seen[10] = { 0 };
+	size_t i;
 	int res;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new(sizeof(int), 0);
 
-	res = scv_insert(v, 0, data1, ARRAY_SIZE(data1));
+	for (i = 0; i < 10; ++i) {
+		int j = (int) i;
+		scv_push_back(v, &j);
+	}
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	res = scv_swap_remove_indices(v, idx, ARRAY_SIZE(idx));
 
-	res = scv_insert(v, 0, data2, ARRAY_SIZE(data2));
+	ASSERT(res == SCV_OK && scv_size(v) == 5);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
-	ASSERT(check_int_vector(v));
+	for (i = 0; i < scv_size(v); ++i) {
+		seen[*(int *) scv_at(v, i)] += 1;
+	}
+
+	ASSERT(seen[1] && seen[3] && seen[4] && seen[5] && seen[6]);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST insert_middle(void)
+TEST swap_remove_indices_unsorted(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { 0, 1, 4 };
-	const int data2[] = { 2, 3 };
+	const size_t idx[] = { 3, 1 };
 	int res;
 
-	v = scv_new(sizeof(int), 25);
-
-	res = scv_insert(v, 0, data1, ARRAY_SIZE(data1));
+	v = scv_new(sizeof(int), 0);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	scv_resize(v, 5);
 
-	res = scv_insert(v, 2, data2, ARRAY_SIZE(data2));
+	res = scv_swap_remove_indices(v, idx, ARRAY_SIZE(idx));
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
-	ASSERT(check_int_vector(v));
+	ASSERT(res == SCV_EINVAL && scv_size(v) == 5);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST insert_end(void)
+/* scv_push_back */
+
+TEST push_back_empty(void)
 {
 	struct scv_vector *v;
-	const int data1[] = { 0, 1, 2 };
-	const int data2[] = { 3, 4 };
+	const int i = 0;
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_insert(v, 0, data1, ARRAY_SIZE(data1));
-
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
-
-	res = scv_insert(v, scv_size(v), data2, ARRAY_SIZE(data2));
+	res = scv_push_back(v, &i);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
+	ASSERT(res == SCV_OK && scv_size(v) == 1);
 	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
@@ -1239,31 +2721,22 @@ TEST insert_end(void)
 	PASS();
 }
 
-TEST insert_nothing(void)
+TEST push_back(void)
 {
 	struct scv_vector *v;
 	const int data[] = { 0, 1, 2, 3, 4 };
+	const int i = 5;
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_insert(v, 0, data, ARRAY_SIZE(data));
-
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
-
-	res = scv_insert(v, 0, NULL, 0);
-
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
-	ASSERT(check_int_vector(v));
-
-	res = scv_insert(v, 2, NULL, 0);
+	res = scv_assign(v, data, ARRAY_SIZE(data));
 
 	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
-	ASSERT(check_int_vector(v));
 
-	res = scv_insert(v, scv_size(v), NULL, 0);
+	res = scv_push_back(v, &i);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) + 1);
 	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
@@ -1271,121 +2744,124 @@ TEST insert_nothing(void)
 	PASS();
 }
 
-TEST insert_null_data(void)
+TEST push_back_growing_capacity(void)
 {
 	struct scv_vector *v;
-	const int data[] = { -1, -1, -1 };
+	int i;
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_insert(v, 0, data, ARRAY_SIZE(data));
-
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
-
-	res = scv_insert(v, 0, NULL, 50);
-
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) + 50);
+	for (i = 0; i < 30; ++i) {
+		res = scv_push_back(v, &i);
+		ASSERT(res == SCV_OK && scv_size(v) == (size_t) i + 1);
+		ASSERT(check_int_vector(v));
+	}
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST insert_growing_capacity(void)
+/* scv_emplace_back_n */
+
+TEST emplace_back_n(void)
 {
+	struct count_allocator ca = { 0, 0, 0, 0, 0 };
+	struct scv_allocator a;
 	struct scv_vector *v;
-	const int data1[] = { 45, 46, 47, 48, 49 };
-	int data2[45];
-	int res;
-	size_t i;
+	int *p;
+	int i;
 
-	for (i = 0; i < ARRAY_SIZE(data2); ++i) {
-		data2[i] = (int) i;
-	}
+	a.allocate = count_allocate;
+	a.reallocate = count_reallocate;
+	a.deallocate = count_deallocate;
+	a.ctx = &ca;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new_with_allocator(sizeof(int), 5, &a);
 
-	res = scv_insert(v, 0, data1, ARRAY_SIZE(data1));
+	p = scv_emplace_back_n(v, 1000);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1));
+	ASSERT(p != NULL && scv_size(v) == 1000 && ca.nrealloc == 1);
 
-	res = scv_insert(v, 0, data2, ARRAY_SIZE(data2));
+	for (i = 0; i < 1000; ++i) {
+		p[i] = i;
+	}
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data1) + ARRAY_SIZE(data2));
 	ASSERT(check_int_vector(v));
 
+	p = scv_emplace_back_n(v, 10);
+
+	ASSERT(p == (int *) scv_data(v) + 1000 && scv_size(v) == 1010);
+
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST insert_nobj_max(void)
+TEST emplace_back_n_zero(void)
 {
 	struct scv_vector *v;
-	int res;
 
-	v = scv_new(sizeof(int), 25);
-
-	res = scv_insert(v, 0, NULL, (size_t) -1);
+	v = scv_new(sizeof(int), 5);
 
-	ASSERT(res != SCV_OK && scv_size(v) == 0);
+	ASSERT(scv_emplace_back_n(v, 0) == NULL && scv_empty(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST insert_outside_range(void)
+TEST emplace_back_n_max(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, 2, 3, 4 };
-	int res;
-
-	v = scv_new(sizeof(int), 25);
-
-	res = scv_insert(v, 0, data, ARRAY_SIZE(data));
-
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	res = scv_insert(v, scv_size(v) + 1, NULL, 0);
+	v = scv_new(sizeof(int), 5);
 
-	ASSERT(res != SCV_OK && scv_size(v) == ARRAY_SIZE(data));
-	ASSERT(check_int_vector(v));
+	ASSERT(scv_emplace_back_n(v, (size_t) -1) == NULL && scv_empty(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_erase */
-
-TEST erase_nothing(void)
+TEST emplace_back_commit(void)
 {
 	struct scv_vector *v;
+	int *p;
 	int res;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new(sizeof(int), 5);
 
-	res = scv_erase(v, 0, 0);
+	p = scv_emplace_back_n(v, 10);
 
-	ASSERT(res == SCV_OK && scv_size(v) == 0);
+	p[0] = 0;
+	p[1] = 1;
+	p[2] = 2;
 
-	scv_resize(v, 10);
+	res = scv_emplace_back_commit(v, 10, 3);
 
-	res = scv_erase(v, 0, 0);
+	ASSERT(res == SCV_OK && scv_size(v) == 3 && check_int_vector(v));
 
-	ASSERT(res == SCV_OK && scv_size(v) == 10);
+	res = scv_emplace_back_commit(v, 4, 0);
+
+	ASSERT(res == SCV_ERANGE && scv_size(v) == 3);
+
+	res = scv_emplace_back_commit(v, 2, 3);
+
+	ASSERT(res == SCV_ERANGE && scv_size(v) == 3);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST erase_start(void)
+/* scv_pop_back */
+
+TEST pop_back(void)
 {
 	struct scv_vector *v;
-	const int data[] = { -1, -1, 0, 1, 2, 3, 4 };
+	const int data[] = { 0, 1, 2, 3, 4 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
@@ -1394,9 +2870,9 @@ TEST erase_start(void)
 
 	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
 
-	res = scv_erase(v, 0, 2);
+	res = scv_pop_back(v);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 2);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 1);
 	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
@@ -1404,211 +2880,306 @@ TEST erase_start(void)
 	PASS();
 }
 
-TEST erase_middle(void)
+TEST pop_back_empty(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, -1, -1, 2, 3, 4 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_assign(v, data, ARRAY_SIZE(data));
-
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
-
-	res = scv_erase(v, 2, 4);
+	res = scv_pop_back(v);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 2);
-	ASSERT(check_int_vector(v));
+	ASSERT(res != SCV_OK && scv_size(v) == 0);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST erase_end(void)
+/* scv_push_front */
+
+TEST push_front(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, 2, 3, 4, -1, -1 };
+	int i;
 	int res;
 
-	v = scv_new(sizeof(int), 25);
-
-	res = scv_assign(v, data, ARRAY_SIZE(data));
+	v = scv_new(sizeof(int), 0);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	for (i = 99; i >= 0; --i) {
+		res = scv_push_front(v, &i);
 
-	res = scv_erase(v, scv_size(v) - 2, scv_size(v));
+		ASSERT(res == SCV_OK && *(int *) scv_front(v) == i);
+	}
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 2);
+	ASSERT(scv_size(v) == 100);
 	ASSERT(check_int_vector(v));
 
+	i = 100;
+
+	res = scv_push_back(v, &i);
+
+	ASSERT(res == SCV_OK && *(int *) scv_back(v) == 100);
+
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST erase_all(void)
+TEST push_front_small(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, 2, 3, 4 };
+	int i;
 	int res;
 
-	v = scv_new(sizeof(int), 25);
-
-	res = scv_assign(v, data, ARRAY_SIZE(data));
+	v = scv_new_small(sizeof(int), 4);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	for (i = 9; i >= 0; --i) {
+		res = scv_push_front(v, &i);
 
-	res = scv_erase(v, 0, scv_size(v));
+		ASSERT(res == SCV_OK);
+	}
 
-	ASSERT(res == SCV_OK && scv_size(v) == 0);
+	ASSERT(scv_size(v) == 10);
+	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST erase_outside_range(void)
+TEST push_front_aligned(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, 2, 3, 4 };
+	int i;
 	int res;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new_aligned(sizeof(int), 0, 64);
 
-	res = scv_assign(v, data, ARRAY_SIZE(data));
+	ASSERT(v != NULL);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	/* Growing the space before the elements keeps them aligned */
+	res = scv_push_front(v, NULL);
 
-	res = scv_erase(v, 2, scv_size(v) + 1);
+	ASSERT(res == SCV_OK && ((size_t) scv_data(v) & 63) == 0);
 
-	ASSERT(res != SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	scv_pop_front(v);
+
+	for (i = 99; i >= 0; --i) {
+		res = scv_push_front(v, &i);
+
+		ASSERT(res == SCV_OK);
+	}
+
+	/* Growing after push_front aligns the elements again */
+	for (i = 100; i < 1000; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	ASSERT(((size_t) scv_data(v) & 63) == 0 && check_int_vector(v));
+
+	res = scv_push_front(v, NULL);
+
+	ASSERT(res == SCV_OK);
+
+	scv_pop_front(v);
+
+	res = scv_reserve(v, 2 * scv_capacity(v));
+
+	ASSERT(res == SCV_OK && ((size_t) scv_data(v) & 63) == 0);
 	ASSERT(check_int_vector(v));
 
 	scv_delete(v);
 
+	/* Elements whose size is not a power of two */
+	v = scv_new_aligned(12, 0, 64);
+
+	ASSERT(v != NULL);
+
+	for (i = 0; i < 50; ++i) {
+		res = scv_push_front(v, NULL);
+
+		ASSERT(res == SCV_OK);
+	}
+
+	res = scv_reserve(v, 2 * scv_capacity(v));
+
+	ASSERT(res == SCV_OK && ((size_t) scv_data(v) & 63) == 0);
+
+	scv_delete(v);
+
 	PASS();
 }
 
-TEST erase_negative_range(void)
+TEST push_front_aligned_mixed(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, 2, 3, 4 };
+	int first = 0;
+	int last = -1;
+	int i;
 	int res;
 
-	v = scv_new(sizeof(int), 25);
+	v = scv_new_aligned(3 * sizeof(int), 0, 64);
 
-	res = scv_assign(v, data, ARRAY_SIZE(data));
+	ASSERT(v != NULL);
+
+	/* Elements of 12 bytes stay aligned through every call */
+	for (i = 0; i < 1000; ++i) {
+		int elem[3];
+
+		if (i % 5 == 3 && scv_size(v) > 0) {
+			res = scv_pop_front(v);
+			first += 1;
+		}
+		else if (i % 5 == 4) {
+			elem[0] = elem[1] = elem[2] = ++last;
+			res = scv_push_back(v, elem);
+		}
+		else {
+			elem[0] = elem[1] = elem[2] = --first;
+			res = scv_push_front(v, elem);
+		}
+
+		ASSERT(res == SCV_OK);
+		ASSERT(scv_size(v) == (size_t) (last - first + 1));
+
+		if (scv_size(v) > 0) {
+			ASSERT(((size_t) scv_data(v) & 63) == 0);
+			ASSERT(((int *) scv_front(v))[2] == first);
+			ASSERT(((int *) scv_back(v))[0] == last);
+		}
+	}
+
+	for (i = 0; i < (int) scv_size(v); ++i) {
+		ASSERT(((int *) scv_at(v, i))[1] == first + i);
+	}
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+	while (scv_size(v) > 0) {
+		res = scv_pop_front(v);
 
-	res = scv_erase(v, 3, 2);
+		ASSERT(res == SCV_OK);
 
-	ASSERT(res != SCV_OK && scv_size(v) == ARRAY_SIZE(data));
-	ASSERT(check_int_vector(v));
+		if (scv_size(v) > 0) {
+			ASSERT(((size_t) scv_data(v) & 63) == 0);
+		}
+	}
 
 	scv_delete(v);
 
 	PASS();
 }
 
-/* scv_push_back */
+/* scv_pop_front */
 
-TEST push_back_empty(void)
+TEST pop_front(void)
 {
 	struct scv_vector *v;
-	const int i = 0;
+	const int data[] = { 42, 0, 1, 2, 3, 4 };
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_push_back(v, &i);
+	res = scv_assign(v, data, ARRAY_SIZE(data));
 
-	ASSERT(res == SCV_OK && scv_size(v) == 1);
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+
+	res = scv_pop_front(v);
+
+	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 1);
 	ASSERT(check_int_vector(v));
+	ASSERT(scv_capacity(v) == 24);
+
+	/* Space before the elements is reused by push_front */
+	res = scv_push_front(v, &data[0]);
+
+	ASSERT(res == SCV_OK && scv_capacity(v) == 25);
+	ASSERT(*(int *) scv_front(v) == 42);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST push_back(void)
+TEST pop_front_empty(void)
 {
 	struct scv_vector *v;
-	const int data[] = { 0, 1, 2, 3, 4 };
-	const int i = 5;
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_assign(v, data, ARRAY_SIZE(data));
-
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
-
-	res = scv_push_back(v, &i);
+	res = scv_pop_front(v);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) + 1);
-	ASSERT(check_int_vector(v));
+	ASSERT(res != SCV_OK && scv_size(v) == 0);
 
 	scv_delete(v);
 
 	PASS();
 }
 
-TEST push_back_growing_capacity(void)
+TEST pop_front_queue(void)
 {
+	struct count_allocator ca = { 0, 0, 0, 0, 0 };
+	struct scv_allocator a = { count_allocate, count_reallocate, count_deallocate, NULL };
 	struct scv_vector *v;
 	int i;
+	int next = 0;
 	int res;
 
-	v = scv_new(sizeof(int), 25);
-
-	for (i = 0; i < 30; ++i) {
-		res = scv_push_back(v, &i);
-		ASSERT(res == SCV_OK && scv_size(v) == (size_t) i + 1);
-		ASSERT(check_int_vector(v));
-	}
+	a.ctx = &ca;
 
-	scv_delete(v);
+	v = scv_new_with_allocator(sizeof(int), 64, &a);
 
-	PASS();
-}
+	ASSERT(v != NULL);
 
-/* scv_pop_back */
+	/* Keep 20 elements queued, space freed at the front is reclaimed */
+	for (i = 0; i < 10000; ++i) {
+		res = scv_push_back(v, &i);
 
-TEST pop_back(void)
-{
-	struct scv_vector *v;
-	const int data[] = { 0, 1, 2, 3, 4 };
-	int res;
+		ASSERT(res == SCV_OK);
 
-	v = scv_new(sizeof(int), 25);
+		if (scv_size(v) > 20) {
+			ASSERT(*(int *) scv_front(v) == next);
 
-	res = scv_assign(v, data, ARRAY_SIZE(data));
+			res = scv_pop_front(v);
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data));
+			ASSERT(res == SCV_OK);
 
-	res = scv_pop_back(v);
+			next += 1;
+		}
+	}
 
-	ASSERT(res == SCV_OK && scv_size(v) == ARRAY_SIZE(data) - 1);
-	ASSERT(check_int_vector(v));
+	ASSERT(scv_size(v) == 20);
+	ASSERT(ca.nalloc == 3 && ca.nrealloc == 0);
 
 	scv_delete(v);
 
+	ASSERT(ca.bytes == 0);
+
 	PASS();
 }
 
-TEST pop_back_empty(void)
+TEST pop_front_to_empty(void)
 {
 	struct scv_vector *v;
+	int i;
 	int res;
 
 	v = scv_new(sizeof(int), 25);
 
-	res = scv_pop_back(v);
+	for (i = 0; i < 10; ++i) {
+		res = scv_push_back(v, &i);
 
-	ASSERT(res != SCV_OK && scv_size(v) == 0);
+		ASSERT(res == SCV_OK);
+	}
+
+	while (!scv_empty(v)) {
+		res = scv_pop_front(v);
+
+		ASSERT(res == SCV_OK);
+	}
+
+	/* All space is available at the back again */
+	ASSERT(scv_capacity(v) == 25);
 
 	scv_delete(v);
 
@@ -1843,6 +3414,125 @@ TEST copy_to_itself(void)
 	PASS();
 }
 
+/* scv_append */
+
+TEST append(void)
+{
+	struct scv_vector *v1;
+	struct scv_vector *v2;
+	const int data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	int res;
+
+	v1 = scv_new(sizeof(int), 0);
+	v2 = scv_new(sizeof(int), 0);
+
+	scv_assign(v1, data, 4);
+	scv_assign(v2, data + 4, 6);
+
+	res = scv_append(v1, v2);
+
+	ASSERT(res == SCV_OK && scv_size(v1) == 10 && check_int_vector(v1));
+	ASSERT(scv_size(v2) == 6);
+
+	scv_delete(v1);
+	scv_delete(v2);
+
+	PASS();
+}
+
+TEST append_objsize_mismatch(void)
+{
+	struct scv_vector *v1;
+	struct scv_vector *v2;
+	int res;
+
+	v1 = scv_new(sizeof(int), 5);
+	v2 = scv_new(sizeof(char), 5);
+
+	res = scv_append(v1, v2);
+
+	ASSERT(res == SCV_EINVAL);
+
+	scv_delete(v1);
+	scv_delete(v2);
+
+	PASS();
+}
+
+TEST append_many(void)
+{
+	struct count_allocator ca = { 0, 0, 0, 0, 0 };
+	struct scv_allocator a;
+	struct scv_vector *dst;
+	struct scv_vector *src[10];
+	size_t i;
+	int j = 0;
+	int res;
+
+	a.allocate = count_allocate;
+	a.reallocate = count_reallocate;
+	a.deallocate = count_deallocate;
+	a.ctx = &ca;
+
+	for (i = 0; i < ARRAY_SIZE(src); ++i) {
+		size_t k;
+
+		src[i] = scv_new(sizeof(int), 0);
+
+		for (k = 0; k < 100; ++k, ++j) {
+			scv_push_back(src[i], &j);
+		}
+	}
+
+	dst = scv_new_with_allocator(sizeof(int), 1, &a);
+
+	res = scv_append_many(dst, (const struct scv_vector *const *) src, ARRAY_SIZE(src));
+
+	ASSERT(res == SCV_OK && scv_size(dst) == 1000 && ca.nrealloc == 1);
+	ASSERT(check_int_vector(dst));
+
+	for (i = 0; i < ARRAY_SIZE(src); ++i) {
+		scv_delete(src[i]);
+	}
+
+	scv_delete(dst);
+
+	PASS();
+}
+
+TEST append_many_self(void)
+{
+	struct scv_vector *v1;
+	struct scv_vector *v2;
+	const struct scv_vector *srcs[3];
+	const int data[] = { 0, 1, 2 };
+	int *p;
+	int res;
+
+	v1 = scv_new(sizeof(int), 0);
+	v2 = scv_new(sizeof(int), 0);
+
+	scv_assign(v1, data, 2);
+	scv_assign(v2, data + 2, 1);
+
+	srcs[0] = v1;
+	srcs[1] = v2;
+	srcs[2] = v1;
+
+	res = scv_append_many(v1, srcs, 3);
+
+	p = scv_data(v1);
+
+	ASSERT(res == SCV_OK && scv_size(v1) == 7);
+	ASSERT(p[0] == 0 && p[1] == 1 && p[2] == 0 && p[3] == 1);
+	ASSERT(p[4] == 2 && p[5] == 0 && p[6] == 1);
+
+	scv_delete(v1);
+	scv_delete(v2);
+
+	PASS();
+}
+
 /* scv_swap */
 
 TEST swap(void)
@@ -1864,15 +3554,231 @@ TEST swap(void)
 	PASS();
 }
 
+TEST swap_different_allocators(void)
+{
+	struct scv_arena *arena;
+	struct scv_vector *v1;
+	struct scv_vector *v2;
+	int i;
+	int res;
+
+	arena = scv_arena_new(0);
+
+	ASSERT(arena != NULL);
+
+	v1 = scv_new(sizeof(int), 0);
+	v2 = scv_new_with_allocator(sizeof(int), 0, scv_arena_allocator(arena));
+
+	ASSERT(v1 != NULL && v2 != NULL);
+
+	for (i = 0; i < 10; ++i) {
+		scv_push_back(v1, &i);
+	}
+
+	res = scv_swap(v1, v2);
+
+	ASSERT(res == SCV_EINVAL && scv_size(v1) == 10 && scv_empty(v2));
+	ASSERT(check_int_vector(v1));
+
+	scv_delete(v1);
+	scv_delete(v2);
+
+	scv_arena_delete(arena);
+
+	PASS();
+}
+
+/* SCV_DECLARE */
+
+SCV_DECLARE(intvec, int)
+
+TEST declare_push_back_and_at(void)
+{
+	struct scv_vector *v;
+	int i;
+
+	v = intvec_new(0);
+
+	ASSERT(v != NULL && scv_objsize(v) == sizeof(int));
+	ASSERT(intvec_front(v) == NULL && intvec_back(v) == NULL);
+
+	for (i = 0; i < 100; ++i) {
+		ASSERT(intvec_push_back(v, i) == SCV_OK);
+	}
+
+	ASSERT(intvec_size(v) == 100 && check_int_vector(v));
+	ASSERT(*intvec_at(v, 42) == 42 && intvec_at(v, 100) == NULL);
+	ASSERT(*intvec_front(v) == 0 && *intvec_back(v) == 99);
+	ASSERT(intvec_at(v, 7) == scv_at(v, 7) && intvec_data(v) == scv_data(v));
+
+	intvec_pop_back(v);
+
+	ASSERT(*intvec_back(v) == 98);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST declare_insert_and_erase(void)
+{
+	struct scv_vector v;
+	const int data[] = { 0, 1, 2, 3, 4 };
+
+	intvec_init(&v);
+
+	intvec_insert(&v, 0, data + 2, 3);
+	intvec_insert(&v, 0, data, 2);
+
+	ASSERT(intvec_size(&v) == 5 && check_int_vector(&v));
+
+	intvec_erase(&v, 3, 5);
+
+	ASSERT(intvec_size(&v) == 3 && check_int_vector(&v));
+
+	scv_destroy(&v);
+
+	PASS();
+}
+
+TEST declare_insert_and_erase_middle(void)
+{
+	struct scv_vector *v;
+	const int data[] = { 3, 4, 5 };
+	int i;
+
+	v = intvec_new(100);
+
+	for (i = 0; i < 10; ++i) {
+		if (i < 3 || i > 5) {
+			intvec_push_back(v, i);
+		}
+	}
+
+	/* Within capacity, into the middle */
+	ASSERT(intvec_insert(v, 3, data, 3) == SCV_OK);
+	ASSERT(intvec_size(v) == 10 && check_int_vector(v));
+
+	ASSERT(intvec_insert(v, 2, NULL, 2) == SCV_OK);
+	ASSERT(intvec_size(v) == 12 && *intvec_at(v, 4) == 2);
+	ASSERT(intvec_erase(v, 2, 4) == SCV_OK);
+	ASSERT(intvec_size(v) == 10 && check_int_vector(v));
+
+	ASSERT(intvec_insert(v, 11, data, 1) == SCV_ERANGE);
+	ASSERT(intvec_erase(v, 5, 4) == SCV_ERANGE);
+	ASSERT(intvec_erase(v, 5, 11) == SCV_ERANGE);
+
+	/* Beyond capacity, through scv_insert() */
+	for (i = 0; i < 200; ++i) {
+		ASSERT(intvec_insert(v, 10, NULL, 1) == SCV_OK);
+		*intvec_at(v, 10) = 10 + 199 - i;
+	}
+
+	ASSERT(intvec_size(v) == 210 && check_int_vector(v));
+
+	ASSERT(intvec_erase(v, 0, 0) == SCV_OK && intvec_erase(v, 5, 210) == SCV_OK);
+	ASSERT(intvec_size(v) == 5 && check_int_vector(v));
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_stats_get */
+
+#if defined(SCV_STATS)
+TEST stats_get(void)
+{
+	struct scv_stats global;
+	struct scv_stats stats;
+	struct scv_vector *v;
+	int i;
+	int res;
+
+	scv_stats_reset(NULL);
+
+	v = scv_new(sizeof(int), 0);
+
+	for (i = 0; i < 100; ++i) {
+		scv_push_back(v, &i);
+	}
+
+	scv_insert(v, 0, NULL, 1);
+	scv_shrink_to_fit(v);
+
+	res = scv_stats_get(v, &stats);
+
+	ASSERT(res == SCV_OK);
+	ASSERT(stats.grows > 0 && stats.shrinks == 1);
+	ASSERT(stats.bytes_copied >= 100 * sizeof(int));
+	ASSERT(stats.bytes_moved == 100 * sizeof(int));
+	ASSERT(stats.peak_capacity >= 101 * sizeof(int));
+
+	scv_stats_get(NULL, &global);
+
+	ASSERT(global.grows == stats.grows && global.bytes_moved == stats.bytes_moved);
+
+	scv_stats_reset(v);
+	scv_stats_get(v, &stats);
+
+	ASSERT(stats.grows == 0 && stats.bytes_copied == 0);
+
+	scv_delete(v);
+
+	PASS();
+}
+#else
+TEST stats_get(void)
+{
+	struct scv_stats stats;
+	int res;
+
+	res = scv_stats_get(NULL, &stats);
+
+	ASSERT(res != SCV_OK && stats.grows == 0);
+
+	PASS();
+}
+#endif
+
 SUITE(scv)
 {
 	RUN_TEST(new_objsize_zero);
 	RUN_TEST(new_capacity_zero);
+	RUN_TEST(new_capacity_zero_no_data);
+	RUN_TEST(new_capacity_zero_reserve);
+	RUN_TEST(new_capacity_zero_copy);
 	RUN_TEST(new_objsize_max);
 	RUN_TEST(new_capacity_max);
 
+	RUN_TEST(new_with_allocator);
+	RUN_TEST(new_with_allocator_null);
+
+	RUN_TEST(arena_grow_in_place);
+	RUN_TEST(arena_many_vectors);
+	RUN_TEST(arena_unaligned_blocksize);
+	RUN_TEST(arena_delete_null);
+
+	RUN_TEST(new_aligned);
+	RUN_TEST(new_aligned_not_power_of_two);
+
+	RUN_TEST(new_small);
+	RUN_TEST(struct_size);
+	RUN_TEST(new_small_layout);
+	RUN_TEST(new_small_spill);
+	RUN_TEST(new_small_swap);
+	RUN_TEST(new_small_objsize_zero);
+
+	RUN_TEST(mmap_allocator);
+
 	RUN_TEST(delete_null);
 
+	RUN_TEST(init);
+	RUN_TEST(init_objsize_zero);
+	RUN_TEST(init_buffer);
+	RUN_TEST(init_buffer_null);
+	RUN_TEST(destroy_null);
+
 	RUN_TEST(at_inside);
 	RUN_TEST(at_outside);
 	RUN_TEST(at_empty);
@@ -1904,6 +3810,16 @@ SUITE(scv)
 
 	RUN_TEST(capacity);
 
+	RUN_TEST(set_growth_exact);
+	RUN_TEST(set_growth_factor);
+	RUN_TEST(set_growth_callback);
+	RUN_TEST(set_growth_invalid_factor);
+
+	RUN_TEST(set_incremental);
+	RUN_TEST(set_incremental_pop_back);
+	RUN_TEST(set_incremental_copy);
+	RUN_TEST(set_incremental_alloc_fail);
+
 	RUN_TEST(shrink_to_fit_empty);
 	RUN_TEST(shrink_to_fit_size_equals_capacity);
 	RUN_TEST(shrink_to_fit_size_below_capacity);
@@ -1948,6 +3864,11 @@ SUITE(scv)
 	RUN_TEST(insert_nobj_max);
 	RUN_TEST(insert_outside_range);
 
+	RUN_TEST(insert_batch);
+	RUN_TEST(insert_batch_empty_vector);
+	RUN_TEST(insert_batch_outside_range);
+	RUN_TEST(insert_batch_unsorted);
+
 	RUN_TEST(erase_nothing);
 	RUN_TEST(erase_start);
 	RUN_TEST(erase_middle);
@@ -1956,13 +3877,41 @@ SUITE(scv)
 	RUN_TEST(erase_outside_range);
 	RUN_TEST(erase_negative_range);
 
+	RUN_TEST(erase_if);
+	RUN_TEST(erase_if_all_and_none);
+	RUN_TEST(erase_if_pred_calls);
+
+	RUN_TEST(erase_indices);
+	RUN_TEST(erase_indices_outside_range);
+	RUN_TEST(erase_indices_unsorted);
+
+	RUN_TEST(swap_remove);
+	RUN_TEST(swap_remove_outside_range);
+	RUN_TEST(swap_remove_indices);
+	RUN_TEST(swap_remove_indices_unsorted);
+
 	RUN_TEST(push_back_empty);
 	RUN_TEST(push_back);
 	RUN_TEST(push_back_growing_capacity);
 
+	RUN_TEST(emplace_back_n);
+	RUN_TEST(emplace_back_n_zero);
+	RUN_TEST(emplace_back_n_max);
+	RUN_TEST(emplace_back_commit);
+
 	RUN_TEST(pop_back);
 	RUN_TEST(pop_back_empty);
 
+	RUN_TEST(push_front);
+	RUN_TEST(push_front_small);
+	RUN_TEST(push_front_aligned);
+	RUN_TEST(push_front_aligned_mixed);
+
+	RUN_TEST(pop_front);
+	RUN_TEST(pop_front_empty);
+	RUN_TEST(pop_front_queue);
+	RUN_TEST(pop_front_to_empty);
+
 	RUN_TEST(resize_zero_size);
 	RUN_TEST(resize_smaller_size);
 	RUN_TEST(resize_equal_size);
@@ -1977,7 +3926,19 @@ SUITE(scv)
 	RUN_TEST(copy_objsize_mismatch);
 	RUN_TEST(copy_to_itself);
 
+	RUN_TEST(append);
+	RUN_TEST(append_objsize_mismatch);
+	RUN_TEST(append_many);
+	RUN_TEST(append_many_self);
+
 	RUN_TEST(swap);
+	RUN_TEST(swap_different_allocators);
+
+	RUN_TEST(declare_push_back_and_at);
+	RUN_TEST(declare_insert_and_erase);
+	RUN_TEST(declare_insert_and_erase_middle);
+
+	RUN_TEST(stats_get);
 }
 
 GREATEST_MAIN_DEFS();
@@ -0,0 +1,261 @@
+/*
+ * scv - Simple C Vector
+ *
+ * test_scv_gap.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "greatest.h"
+
+#include "scv_gap.h"
+
+#ifndef ARRAY_SIZE
+# define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+#endif
+
+static int check_int_gap(struct scv_gap *g, const int *expected, size_t n)
+{
+	size_t i;
+
+	if (scv_gap_size(g) != n) {
+		return 0;
+	}
+
+	for (i = 0; i < n; ++i) {
+		if (*(int *) scv_gap_at(g, i) != expected[i]) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/* scv_gap_new */
+
+TEST gap_new(void)
+{
+	struct scv_gap *g = scv_gap_new(sizeof(int), 10);
+
+	ASSERT(g != NULL);
+	ASSERT_EQ(scv_gap_size(g), 0);
+	ASSERT_EQ(scv_gap_objsize(g), sizeof(int));
+	ASSERT_EQ(scv_gap_at(g, 0), NULL);
+	ASSERT_EQ(scv_gap_data(g), NULL);
+
+	scv_gap_delete(g);
+
+	PASS();
+}
+
+TEST gap_new_zero_objsize(void)
+{
+	struct scv_gap *g = scv_gap_new(0, 10);
+
+	ASSERT_EQ(g, NULL);
+
+	PASS();
+}
+
+/* scv_gap_insert */
+
+TEST gap_insert(void)
+{
+	static const int expected[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+	int a[] = { 0, 1, 6, 7 };
+	int b[] = { 2, 5 };
+	int c[] = { 3, 4 };
+	struct scv_gap *g = scv_gap_new(sizeof(int), 0);
+
+	ASSERT(g != NULL);
+
+	ASSERT_EQ(scv_gap_insert(g, 0, a, ARRAY_SIZE(a)), SCV_OK);
+	ASSERT_EQ(scv_gap_cursor(g), 4);
+	ASSERT_EQ(scv_gap_insert(g, 2, b, ARRAY_SIZE(b)), SCV_OK);
+	ASSERT_EQ(scv_gap_cursor(g), 4);
+	ASSERT_EQ(scv_gap_insert(g, 3, c, ARRAY_SIZE(c)), SCV_OK);
+	ASSERT_EQ(scv_gap_cursor(g), 5);
+
+	ASSERT(check_int_gap(g, expected, ARRAY_SIZE(expected)));
+
+	ASSERT_EQ(scv_gap_insert(g, 9, a, 1), SCV_ERANGE);
+
+	scv_gap_delete(g);
+
+	PASS();
+}
+
+TEST gap_insert_many(void)
+{
+	static int ref[1000];
+	struct scv_gap *g = scv_gap_new(sizeof(int), 0);
+	size_t pos = 0;
+	size_t n;
+
+	ASSERT(g != NULL);
+
+	/* Insert at positions that drift back and forth, mirrored in ref */
+	for (n = 0; n < ARRAY_SIZE(ref); ++n) {
+		int val = (int) n;
+
+		pos = (pos + n * 7) % (n + 1);
+
+		memmove(&ref[pos + 1], &ref[pos], (n - pos) * sizeof(int));
+		ref[pos] = val;
+
+		ASSERT_EQ(scv_gap_insert(g, pos, &val, 1), SCV_OK);
+	}
+
+	ASSERT(check_int_gap(g, ref, ARRAY_SIZE(ref)));
+
+	scv_gap_delete(g);
+
+	PASS();
+}
+
+/* scv_gap_erase */
+
+TEST gap_erase(void)
+{
+	static const int expected[] = { 0, 1, 5, 6, 7 };
+	static const int expected2[] = { 0, 6, 7 };
+	int a[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+	struct scv_gap *g = scv_gap_new(sizeof(int), 0);
+
+	ASSERT(g != NULL);
+
+	ASSERT_EQ(scv_gap_insert(g, 0, a, ARRAY_SIZE(a)), SCV_OK);
+
+	ASSERT_EQ(scv_gap_erase(g, 2, 5), SCV_OK);
+	ASSERT_EQ(scv_gap_cursor(g), 2);
+	ASSERT(check_int_gap(g, expected, ARRAY_SIZE(expected)));
+
+	ASSERT_EQ(scv_gap_erase(g, 1, 3), SCV_OK);
+	ASSERT(check_int_gap(g, expected2, ARRAY_SIZE(expected2)));
+
+	ASSERT_EQ(scv_gap_erase(g, 2, 1), SCV_ERANGE);
+	ASSERT_EQ(scv_gap_erase(g, 2, 4), SCV_ERANGE);
+
+	scv_gap_delete(g);
+
+	PASS();
+}
+
+/* scv_gap_replace */
+
+TEST gap_replace(void)
+{
+	static const int expected[] = { 0, 9, 9, 9, 4, 5 };
+	int a[] = { 0, 1, 2, 3, 4, 5 };
+	int b[] = { 9, 9, 9 };
+	struct scv_gap *g = scv_gap_new(sizeof(int), 0);
+
+	ASSERT(g != NULL);
+
+	ASSERT_EQ(scv_gap_insert(g, 0, a, ARRAY_SIZE(a)), SCV_OK);
+	ASSERT_EQ(scv_gap_move(g, 0), SCV_OK);
+
+	ASSERT_EQ(scv_gap_replace(g, 1, 4, b, ARRAY_SIZE(b)), SCV_OK);
+	ASSERT_EQ(scv_gap_cursor(g), 4);
+	ASSERT(check_int_gap(g, expected, ARRAY_SIZE(expected)));
+
+	scv_gap_delete(g);
+
+	PASS();
+}
+
+/* scv_gap_move */
+
+TEST gap_move(void)
+{
+	int a[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+	struct scv_gap *g = scv_gap_new(sizeof(int), 16);
+	size_t i;
+
+	ASSERT(g != NULL);
+
+	ASSERT_EQ(scv_gap_insert(g, 0, a, ARRAY_SIZE(a)), SCV_OK);
+
+	for (i = 0; i <= ARRAY_SIZE(a); ++i) {
+		ASSERT_EQ(scv_gap_move(g, (ARRAY_SIZE(a) - i) * 3 % 9), SCV_OK);
+		ASSERT(check_int_gap(g, a, ARRAY_SIZE(a)));
+	}
+
+	ASSERT_EQ(scv_gap_move(g, ARRAY_SIZE(a) + 1), SCV_ERANGE);
+
+	scv_gap_delete(g);
+
+	PASS();
+}
+
+/* scv_gap_data */
+
+TEST gap_data(void)
+{
+	int a[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+	struct scv_gap *g = scv_gap_new(sizeof(int), 0);
+	int *p;
+	size_t i;
+
+	ASSERT(g != NULL);
+
+	ASSERT_EQ(scv_gap_insert(g, 0, a, ARRAY_SIZE(a)), SCV_OK);
+	ASSERT_EQ(scv_gap_move(g, 3), SCV_OK);
+
+	p = (int *) scv_gap_data(g);
+
+	ASSERT(p != NULL);
+	ASSERT_EQ(scv_gap_cursor(g), ARRAY_SIZE(a));
+
+	for (i = 0; i < ARRAY_SIZE(a); ++i) {
+		ASSERT_EQ(p[i], a[i]);
+	}
+
+	scv_gap_delete(g);
+
+	PASS();
+}
+
+SUITE(scv_gap)
+{
+	RUN_TEST(gap_new);
+	RUN_TEST(gap_new_zero_objsize);
+
+	RUN_TEST(gap_insert);
+	RUN_TEST(gap_insert_many);
+
+	RUN_TEST(gap_erase);
+
+	RUN_TEST(gap_replace);
+
+	RUN_TEST(gap_move);
+
+	RUN_TEST(gap_data);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char *argv[])
+{
+	GREATEST_MAIN_BEGIN();
+	RUN_SUITE(scv_gap);
+	GREATEST_MAIN_END();
+}
@@ -0,0 +1,357 @@
+/*
+ * scv - Simple C Vector
+ *
+ * test_scv_rope.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "greatest.h"
+
+#include "scv_rope.h"
+
+#ifndef ARRAY_SIZE
+# define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+#endif
+
+/* Reference array the tests mirror edits in */
+static int ref[100000];
+
+static int check_int_rope(struct scv_rope *r, const int *expected, size_t n)
+{
+	size_t i;
+
+	if (scv_rope_size(r) != n) {
+		return 0;
+	}
+
+	for (i = 0; i < n; ++i) {
+		if (*(int *) scv_rope_at(r, i) != expected[i]) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/* scv_rope_new */
+
+TEST rope_new(void)
+{
+	struct scv_rope *r = scv_rope_new(sizeof(int));
+
+	ASSERT(r != NULL);
+	ASSERT_EQ(scv_rope_size(r), 0);
+	ASSERT_EQ(scv_rope_objsize(r), sizeof(int));
+	ASSERT_EQ(scv_rope_at(r, 0), NULL);
+
+	scv_rope_delete(r);
+
+	PASS();
+}
+
+TEST rope_new_zero_objsize(void)
+{
+	struct scv_rope *r = scv_rope_new(0);
+
+	ASSERT_EQ(r, NULL);
+
+	PASS();
+}
+
+/* scv_rope_insert */
+
+TEST rope_insert(void)
+{
+	static const int expected[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+	int a[] = { 0, 1, 6, 7 };
+	int b[] = { 2, 5 };
+	int c[] = { 3, 4 };
+	struct scv_rope *r = scv_rope_new(sizeof(int));
+
+	ASSERT(r != NULL);
+
+	ASSERT_EQ(scv_rope_insert(r, 0, a, ARRAY_SIZE(a)), SCV_OK);
+	ASSERT_EQ(scv_rope_insert(r, 2, b, ARRAY_SIZE(b)), SCV_OK);
+	ASSERT_EQ(scv_rope_insert(r, 3, c, ARRAY_SIZE(c)), SCV_OK);
+
+	ASSERT(check_int_rope(r, expected, ARRAY_SIZE(expected)));
+
+	ASSERT_EQ(scv_rope_insert(r, 9, a, 1), SCV_ERANGE);
+
+	scv_rope_delete(r);
+
+	PASS();
+}
+
+TEST rope_insert_many(void)
+{
+	struct scv_rope *r = scv_rope_new(sizeof(int));
+	size_t pos = 0;
+	size_t n;
+
+	ASSERT(r != NULL);
+
+	/* Enough elements for two levels of chunks */
+	for (n = 0; n < 20000; ++n) {
+		int val = (int) n;
+
+		pos = (pos * 31 + 17) % (n + 1);
+
+		memmove(&ref[pos + 1], &ref[pos], (n - pos) * sizeof(int));
+		ref[pos] = val;
+
+		ASSERT_EQ(scv_rope_insert(r, pos, &val, 1), SCV_OK);
+	}
+
+	ASSERT(check_int_rope(r, ref, 20000));
+
+	scv_rope_delete(r);
+
+	PASS();
+}
+
+/* scv_rope_erase */
+
+TEST rope_erase(void)
+{
+	struct scv_rope *r = scv_rope_new(sizeof(int));
+	size_t n = ARRAY_SIZE(ref);
+	size_t i;
+
+	ASSERT(r != NULL);
+
+	for (i = 0; i < n; ++i) {
+		ref[i] = (int) i;
+	}
+
+	ASSERT_EQ(scv_rope_insert(r, 0, ref, n), SCV_OK);
+
+	/* Erase ranges of varying length, some spanning several chunks */
+	for (i = 0; n > 0; ++i) {
+		size_t start = (i * 7919) % n;
+		size_t len = (i % 5 == 0) ? 3000 : i % 13;
+
+		if (len > n - start) {
+			len = n - start;
+		}
+
+		memmove(&ref[start], &ref[start + len], (n - start - len) * sizeof(int));
+		n -= len;
+
+		ASSERT_EQ(scv_rope_erase(r, start, start + len), SCV_OK);
+
+		if (i % 64 == 0) {
+			ASSERT(check_int_rope(r, ref, n));
+		}
+	}
+
+	ASSERT_EQ(scv_rope_size(r), 0);
+
+	ASSERT_EQ(scv_rope_erase(r, 0, 1), SCV_ERANGE);
+
+	scv_rope_delete(r);
+
+	PASS();
+}
+
+TEST rope_erase_rebalance(void)
+{
+	struct big {
+		int val;
+		char pad[1020];
+	} b;
+	struct scv_rope *r = scv_rope_new(sizeof(struct big));
+	size_t n = 0;
+	size_t k;
+	size_t i;
+	int round;
+
+	ASSERT(r != NULL);
+
+	memset(&b, 0, sizeof b);
+
+	/* Few elements per chunk, so inner nodes are emptied and refilled
+	 * unevenly, and must be merged and rebalanced */
+	for (round = 0; round < 4; ++round) {
+		for (i = 0; n < 20000; ++i) {
+			size_t pos = (i * 7919 + (size_t) round) % (n + 1);
+
+			b.val = (int) (round * 100000 + (int) i);
+
+			memmove(&ref[pos + 1], &ref[pos], (n - pos) * sizeof(int));
+			ref[pos] = b.val;
+			n += 1;
+
+			ASSERT_EQ(scv_rope_insert(r, pos, &b, 1), SCV_OK);
+		}
+
+		for (i = 0; n > 500; ++i) {
+			size_t start = (i * 104729) % n;
+			size_t len = 1 + i % 17;
+
+			if (len > n - start) {
+				len = n - start;
+			}
+
+			memmove(&ref[start], &ref[start + len], (n - start - len) * sizeof(int));
+			n -= len;
+
+			ASSERT_EQ(scv_rope_erase(r, start, start + len), SCV_OK);
+		}
+
+		ASSERT_EQ(scv_rope_size(r), n);
+
+		for (k = 0; k < n; ++k) {
+			ASSERT_EQ(((struct big *) scv_rope_at(r, k))->val, ref[k]);
+		}
+	}
+
+	scv_rope_delete(r);
+
+	PASS();
+}
+
+/* scv_rope_replace */
+
+TEST rope_replace(void)
+{
+	static const int expected[] = { 0, 9, 9, 9, 4, 5 };
+	int a[] = { 0, 1, 2, 3, 4, 5 };
+	int b[] = { 9, 9, 9 };
+	struct scv_rope *r = scv_rope_new(sizeof(int));
+
+	ASSERT(r != NULL);
+
+	ASSERT_EQ(scv_rope_insert(r, 0, a, ARRAY_SIZE(a)), SCV_OK);
+
+	ASSERT_EQ(scv_rope_replace(r, 1, 4, b, ARRAY_SIZE(b)), SCV_OK);
+	ASSERT(check_int_rope(r, expected, ARRAY_SIZE(expected)));
+
+	ASSERT_EQ(scv_rope_replace(r, 4, 3, b, 1), SCV_ERANGE);
+	ASSERT_EQ(scv_rope_replace(r, 0, 7, b, 1), SCV_ERANGE);
+
+	scv_rope_delete(r);
+
+	PASS();
+}
+
+/* scv_rope_seek */
+
+TEST rope_cursor(void)
+{
+	struct scv_rope *r = scv_rope_new(sizeof(int));
+	struct scv_rope_cursor c;
+	size_t total = 0;
+	size_t n;
+	size_t i;
+	int *p;
+
+	ASSERT(r != NULL);
+
+	ASSERT_EQ(scv_rope_seek(r, &c, 0), SCV_OK);
+	ASSERT_EQ(scv_rope_next(r, &c, &n), NULL);
+
+	for (i = 0; i < ARRAY_SIZE(ref); ++i) {
+		ref[i] = (int) i;
+	}
+
+	ASSERT_EQ(scv_rope_insert(r, 0, ref, ARRAY_SIZE(ref)), SCV_OK);
+
+	ASSERT_EQ(scv_rope_seek(r, &c, 12345), SCV_OK);
+
+	while ((p = (int *) scv_rope_next(r, &c, &n)) != NULL) {
+		ASSERT(n > 0);
+
+		for (i = 0; i < n; ++i) {
+			ASSERT_EQ(p[i], (int) (12345 + total + i));
+		}
+
+		total += n;
+	}
+
+	ASSERT_EQ(total, ARRAY_SIZE(ref) - 12345);
+
+	ASSERT_EQ(scv_rope_seek(r, &c, ARRAY_SIZE(ref) + 1), SCV_ERANGE);
+
+	scv_rope_delete(r);
+
+	PASS();
+}
+
+/* scv_rope_flatten */
+
+TEST rope_flatten(void)
+{
+	struct scv_rope *r = scv_rope_new(sizeof(int));
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	struct scv_vector *w = scv_new(sizeof(char), 0);
+	size_t i;
+
+	ASSERT(r != NULL && v != NULL && w != NULL);
+
+	for (i = 0; i < ARRAY_SIZE(ref); ++i) {
+		int val = (int) i;
+
+		ref[i] = (int) i;
+
+		ASSERT_EQ(scv_rope_insert(r, i, &val, 1), SCV_OK);
+	}
+
+	ASSERT_EQ(scv_rope_flatten(r, v), SCV_OK);
+	ASSERT_EQ(scv_size(v), ARRAY_SIZE(ref));
+	ASSERT_MEM_EQ(ref, scv_data(v), sizeof(ref));
+
+	ASSERT_EQ(scv_rope_flatten(r, w), SCV_EINVAL);
+
+	scv_delete(w);
+	scv_delete(v);
+	scv_rope_delete(r);
+
+	PASS();
+}
+
+SUITE(scv_rope)
+{
+	RUN_TEST(rope_new);
+	RUN_TEST(rope_new_zero_objsize);
+
+	RUN_TEST(rope_insert);
+	RUN_TEST(rope_insert_many);
+
+	RUN_TEST(rope_erase);
+	RUN_TEST(rope_erase_rebalance);
+
+	RUN_TEST(rope_replace);
+
+	RUN_TEST(rope_cursor);
+
+	RUN_TEST(rope_flatten);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char *argv[])
+{
+	GREATEST_MAIN_BEGIN();
+	RUN_SUITE(scv_rope);
+	GREATEST_MAIN_END();
+}
@@ -0,0 +1,266 @@
+/*
+ * scv - Simple C Vector
+ *
+ * test_scv_seg.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "greatest.h"
+
+#include "scv_seg.h"
+
+/* scv_seg_new */
+
+TEST seg_new(void)
+{
+	struct scv_seg *s = scv_seg_new(sizeof(int), 0);
+
+	ASSERT(s != NULL);
+	ASSERT_EQ(scv_seg_size(s), 0);
+	ASSERT_EQ(scv_seg_objsize(s), sizeof(int));
+	ASSERT_EQ(scv_seg_capacity(s), 0);
+	ASSERT_EQ(scv_seg_at(s, 0), NULL);
+
+	scv_seg_delete(s);
+
+	PASS();
+}
+
+TEST seg_new_zero_objsize(void)
+{
+	struct scv_seg *s = scv_seg_new(0, 0);
+
+	ASSERT_EQ(s, NULL);
+
+	PASS();
+}
+
+/* scv_seg_push_back */
+
+TEST seg_push_back(void)
+{
+	struct scv_seg *s = scv_seg_new(sizeof(int), 3);
+	int i;
+
+	ASSERT(s != NULL);
+
+	for (i = 0; i < 1000; ++i) {
+		ASSERT_EQ(scv_seg_push_back(s, &i), SCV_OK);
+	}
+
+	ASSERT_EQ(scv_seg_size(s), 1000);
+	ASSERT(scv_seg_capacity(s) >= 1000);
+
+	for (i = 0; i < 1000; ++i) {
+		int *p = (int *) scv_seg_at(s, (size_t) i);
+
+		ASSERT(p != NULL);
+		ASSERT_EQ(*p, i);
+	}
+
+	ASSERT_EQ(scv_seg_at(s, 1000), NULL);
+
+	scv_seg_delete(s);
+
+	PASS();
+}
+
+TEST seg_push_back_stable(void)
+{
+	struct scv_seg *s = scv_seg_new(sizeof(int), 1);
+	int *first;
+	int *mid;
+	int i;
+
+	ASSERT(s != NULL);
+
+	for (i = 0; i < 100; ++i) {
+		ASSERT_EQ(scv_seg_push_back(s, &i), SCV_OK);
+	}
+
+	first = (int *) scv_seg_at(s, 0);
+	mid = (int *) scv_seg_at(s, 50);
+
+	for (i = 100; i < 10000; ++i) {
+		ASSERT_EQ(scv_seg_push_back(s, &i), SCV_OK);
+	}
+
+	/* Growth does not move existing elements */
+	ASSERT_EQ(scv_seg_at(s, 0), first);
+	ASSERT_EQ(scv_seg_at(s, 50), mid);
+	ASSERT_EQ(*first, 0);
+	ASSERT_EQ(*mid, 50);
+
+	scv_seg_delete(s);
+
+	PASS();
+}
+
+/* scv_seg_pop_back */
+
+TEST seg_pop_back(void)
+{
+	struct scv_seg *s = scv_seg_new(sizeof(int), 4);
+	int i;
+
+	ASSERT(s != NULL);
+
+	ASSERT(scv_seg_pop_back(s) != SCV_OK);
+
+	for (i = 0; i < 10; ++i) {
+		ASSERT_EQ(scv_seg_push_back(s, &i), SCV_OK);
+	}
+
+	ASSERT_EQ(scv_seg_pop_back(s), SCV_OK);
+	ASSERT_EQ(scv_seg_size(s), 9);
+	ASSERT_EQ(*(int *) scv_seg_at(s, 8), 8);
+
+	ASSERT_EQ(scv_seg_clear(s), SCV_OK);
+	ASSERT_EQ(scv_seg_size(s), 0);
+	ASSERT(scv_seg_capacity(s) >= 10);
+
+	scv_seg_delete(s);
+
+	PASS();
+}
+
+/* scv_seg_reserve */
+
+TEST seg_reserve(void)
+{
+	struct scv_seg *s = scv_seg_new(sizeof(int), 4);
+
+	ASSERT(s != NULL);
+
+	ASSERT_EQ(scv_seg_reserve(s, 100), SCV_OK);
+	ASSERT(scv_seg_capacity(s) >= 100);
+	ASSERT_EQ(scv_seg_size(s), 0);
+
+	ASSERT(scv_seg_reserve(s, (size_t) -1) != SCV_OK);
+
+	scv_seg_delete(s);
+
+	PASS();
+}
+
+/* scv_seg_segment */
+
+TEST seg_segment(void)
+{
+	struct scv_seg *s = scv_seg_new(sizeof(int), 4);
+	size_t k;
+	size_t n;
+	size_t total = 0;
+	int next = 0;
+	int *p;
+	int i;
+
+	ASSERT(s != NULL);
+
+	ASSERT_EQ(scv_seg_segment(s, 0, &n), NULL);
+	ASSERT_EQ(n, 0);
+
+	for (i = 0; i < 50; ++i) {
+		ASSERT_EQ(scv_seg_push_back(s, &i), SCV_OK);
+	}
+
+	for (k = 0; (p = (int *) scv_seg_segment(s, k, &n)) != NULL; ++k) {
+		size_t j;
+
+		ASSERT(n > 0);
+
+		for (j = 0; j < n; ++j) {
+			ASSERT_EQ(p[j], next);
+			++next;
+		}
+
+		total += n;
+	}
+
+	/* Segments of 4, 8, 16, and 22 of 32 elements */
+	ASSERT_EQ(k, 4);
+	ASSERT_EQ(total, 50);
+
+	scv_seg_delete(s);
+
+	PASS();
+}
+
+TEST seg_at_segment_bounds(void)
+{
+	static const size_t bases[] = { 1, 2, 16, 64 };
+	size_t b;
+
+	for (b = 0; b < sizeof bases / sizeof bases[0]; ++b) {
+		struct scv_seg *s = scv_seg_new(sizeof(int), bases[b]);
+		size_t start = 0;
+		size_t k;
+		size_t n;
+		char *p;
+		int i;
+
+		ASSERT(s != NULL);
+
+		for (i = 0; i < 5000; ++i) {
+			ASSERT_EQ(scv_seg_push_back(s, &i), SCV_OK);
+		}
+
+		/* First and last element of each segment map into it */
+		for (k = 0; (p = (char *) scv_seg_segment(s, k, &n)) != NULL; ++k) {
+			ASSERT_EQ(n, start + (bases[b] << k) <= 5000 ? bases[b] << k : 5000 - start);
+			ASSERT_EQ((char *) scv_seg_at(s, start), p);
+			ASSERT_EQ((char *) scv_seg_at(s, start + n - 1), p + (n - 1) * sizeof(int));
+
+			start += n;
+		}
+
+		ASSERT_EQ(start, 5000);
+
+		scv_seg_delete(s);
+	}
+
+	PASS();
+}
+
+SUITE(scv_seg)
+{
+	RUN_TEST(seg_new);
+	RUN_TEST(seg_new_zero_objsize);
+
+	RUN_TEST(seg_push_back);
+	RUN_TEST(seg_push_back_stable);
+
+	RUN_TEST(seg_pop_back);
+
+	RUN_TEST(seg_reserve);
+
+	RUN_TEST(seg_segment);
+	RUN_TEST(seg_at_segment_bounds);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char *argv[])
+{
+	GREATEST_MAIN_BEGIN();
+	RUN_SUITE(scv_seg);
+	GREATEST_MAIN_END();
+}
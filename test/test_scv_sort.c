@@ -0,0 +1,770 @@
+/*
+ * scv - Simple C Vector
+ *
+ * test_scv_sort.c
+ *
+ * Copyright 2003-2014 Joergen Ibsen
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "greatest.h"
+
+#include "scv_sort.h"
+
+#ifndef ARRAY_SIZE
+# define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+#endif
+
+struct big {
+	int key;
+	char payload[300];
+};
+
+struct rec {
+	int key;
+	int other[2];
+};
+
+static unsigned long rand_state = 1;
+
+static int next_rand(void)
+{
+	rand_state = rand_state * 1103515245ul + 12345ul;
+
+	return (int) ((rand_state >> 8) & 0x7FFFFF);
+}
+
+static int compare_int(const void *lhs, const void *rhs)
+{
+	int a = *(const int *) lhs;
+	int b = *(const int *) rhs;
+
+	return (a > b) - (a < b);
+}
+
+static int compare_int_ctx(const void *lhs, const void *rhs, void *ctx)
+{
+	int sign = *(const int *) ctx;
+
+	return sign * compare_int(lhs, rhs);
+}
+
+/*
+ * Fill `v` with `n` ints following `pattern`.
+ */
+static void fill_ints(struct scv_vector *v, size_t n, int pattern)
+{
+	size_t i;
+
+	scv_clear(v);
+
+	for (i = 0; i < n; ++i) {
+		int val;
+
+		switch (pattern) {
+		case 0: val = next_rand(); break;
+		case 1: val = (int) i; break;
+		case 2: val = (int) (n - i); break;
+		case 3: val = next_rand() % 4; break;
+		case 4: val = 7; break;
+		case 5: val = (int) (i < n / 2 ? i : n - i); break;
+		default: val = (int) i ^ (next_rand() % 64 == 0 ? 255 : 0); break;
+		}
+
+		scv_push_back(v, &val);
+	}
+}
+
+static int is_sorted_int(struct scv_vector *v)
+{
+	size_t i;
+
+	for (i = 1; i < scv_size(v); ++i) {
+		if (*(int *) scv_at(v, i - 1) > *(int *) scv_at(v, i)) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/* scv_sort */
+
+TEST sort_empty(void)
+{
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	int val = 42;
+
+	ASSERT(v != NULL);
+
+	ASSERT_EQ(scv_sort(v, compare_int), SCV_OK);
+
+	scv_push_back(v, &val);
+
+	ASSERT_EQ(scv_sort(v, compare_int), SCV_OK);
+	ASSERT_EQ(*(int *) scv_at(v, 0), 42);
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST sort_patterns(void)
+{
+	static const size_t sizes[] = { 2, 10, 25, 100, 129, 1000, 50000 };
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	struct scv_vector *w = scv_new(sizeof(int), 0);
+	size_t k;
+	int pattern;
+
+	ASSERT(v != NULL && w != NULL);
+
+	for (pattern = 0; pattern < 7; ++pattern) {
+		for (k = 0; k < ARRAY_SIZE(sizes); ++k) {
+			fill_ints(v, sizes[k], pattern);
+
+			ASSERT_EQ(scv_copy(w, v), SCV_OK);
+
+			qsort(scv_data(w), scv_size(w), sizeof(int), compare_int);
+
+			ASSERT_EQ(scv_sort(v, compare_int), SCV_OK);
+			ASSERT_MEM_EQ(scv_data(w), scv_data(v), scv_size(v) * sizeof(int));
+		}
+	}
+
+	scv_delete(w);
+	scv_delete(v);
+
+	PASS();
+}
+
+static int compare_rec(const void *lhs, const void *rhs)
+{
+	return compare_int(lhs, rhs);
+}
+
+TEST sort_objsize(void)
+{
+	struct scv_vector *v8 = scv_new(2 * sizeof(int), 0);
+	struct scv_vector *v12 = scv_new(sizeof(struct rec), 0);
+	struct scv_vector *vbig = scv_new(sizeof(struct big), 0);
+	size_t i;
+
+	ASSERT(v8 != NULL && v12 != NULL && vbig != NULL);
+
+	for (i = 0; i < 2000; ++i) {
+		struct rec r;
+		struct big b;
+		int pair[2];
+
+		pair[0] = next_rand() % 500;
+		pair[1] = pair[0] * 3;
+		r.key = pair[0];
+		r.other[0] = -r.key;
+		r.other[1] = r.key + 1;
+
+		scv_push_back(v8, pair);
+		scv_push_back(v12, &r);
+
+		if (i < 300) {
+			memset(&b, 0, sizeof b);
+			b.key = pair[0];
+			b.payload[299] = (char) (b.key & 0x7F);
+			scv_push_back(vbig, &b);
+		}
+	}
+
+	ASSERT_EQ(scv_sort(v8, compare_int), SCV_OK);
+	ASSERT_EQ(scv_sort(v12, compare_rec), SCV_OK);
+	ASSERT_EQ(scv_sort(vbig, compare_int), SCV_OK);
+
+	for (i = 0; i < scv_size(v8); ++i) {
+		const int *pair = (const int *) scv_at(v8, i);
+		const struct rec *r = (const struct rec *) scv_at(v12, i);
+
+		ASSERT_EQ(pair[1], pair[0] * 3);
+		ASSERT(r->other[0] == -r->key && r->other[1] == r->key + 1);
+
+		if (i > 0) {
+			ASSERT(pair[0] >= ((const int *) scv_at(v8, i - 1))[0]);
+			ASSERT(r->key >= ((const struct rec *) scv_at(v12, i - 1))->key);
+		}
+	}
+
+	for (i = 0; i < scv_size(vbig); ++i) {
+		const struct big *b = (const struct big *) scv_at(vbig, i);
+
+		ASSERT_EQ(b->payload[299], (char) (b->key & 0x7F));
+
+		if (i > 0) {
+			ASSERT(b->key >= ((const struct big *) scv_at(vbig, i - 1))->key);
+		}
+	}
+
+	scv_delete(vbig);
+	scv_delete(v12);
+	scv_delete(v8);
+
+	PASS();
+}
+
+/* scv_sort_ctx */
+
+TEST sort_ctx(void)
+{
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	int sign = -1;
+	size_t i;
+
+	ASSERT(v != NULL);
+
+	fill_ints(v, 10000, 0);
+
+	ASSERT_EQ(scv_sort_ctx(v, compare_int_ctx, &sign), SCV_OK);
+
+	for (i = 1; i < scv_size(v); ++i) {
+		ASSERT(*(int *) scv_at(v, i - 1) >= *(int *) scv_at(v, i));
+	}
+
+	sign = 1;
+
+	ASSERT_EQ(scv_sort_ctx(v, compare_int_ctx, &sign), SCV_OK);
+	ASSERT(is_sorted_int(v));
+
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_sort_parallel */
+
+TEST sort_parallel_small(void)
+{
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	struct scv_vector *w = scv_new(sizeof(int), 0);
+
+	ASSERT(v != NULL && w != NULL);
+
+	ASSERT_EQ(scv_sort_parallel(v, compare_int, 4), SCV_OK);
+
+	fill_ints(v, 1000, 0);
+
+	ASSERT_EQ(scv_copy(w, v), SCV_OK);
+
+	qsort(scv_data(w), scv_size(w), sizeof(int), compare_int);
+
+	ASSERT_EQ(scv_sort_parallel(v, compare_int, 4), SCV_OK);
+	ASSERT_MEM_EQ(scv_data(w), scv_data(v), scv_size(v) * sizeof(int));
+
+	scv_delete(w);
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST sort_parallel(void)
+{
+	static const size_t nthreads[] = { 0, 1, 2, 3, 5, 8 };
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	struct scv_vector *w = scv_new(sizeof(int), 0);
+	size_t k;
+	int pattern;
+
+	ASSERT(v != NULL && w != NULL);
+
+	for (pattern = 0; pattern < 7; ++pattern) {
+		for (k = 0; k < ARRAY_SIZE(nthreads); ++k) {
+			fill_ints(v, 200003, pattern);
+
+			ASSERT_EQ(scv_copy(w, v), SCV_OK);
+
+			qsort(scv_data(w), scv_size(w), sizeof(int), compare_int);
+
+			ASSERT_EQ(scv_sort_parallel(v, compare_int, nthreads[k]), SCV_OK);
+			ASSERT_MEM_EQ(scv_data(w), scv_data(v), scv_size(v) * sizeof(int));
+		}
+	}
+
+	scv_delete(w);
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST sort_parallel_objsize(void)
+{
+	struct scv_vector *v = scv_new(sizeof(struct rec), 0);
+	size_t i;
+
+	ASSERT(v != NULL);
+
+	for (i = 0; i < 100000; ++i) {
+		struct rec r;
+
+		r.key = next_rand() % 1000;
+		r.other[0] = -r.key;
+		r.other[1] = r.key + 1;
+
+		scv_push_back(v, &r);
+	}
+
+	ASSERT_EQ(scv_sort_parallel(v, compare_rec, 3), SCV_OK);
+
+	for (i = 0; i < scv_size(v); ++i) {
+		const struct rec *r = (const struct rec *) scv_at(v, i);
+
+		ASSERT(r->other[0] == -r->key && r->other[1] == r->key + 1);
+
+		if (i > 0) {
+			ASSERT(r->key >= ((const struct rec *) scv_at(v, i - 1))->key);
+		}
+	}
+
+	scv_delete(v);
+
+	PASS();
+}
+
+#if defined(SCV_NO_THREADS)
+TEST sort_parallel_no_threads(void)
+{
+	static const size_t nthreads[] = { 0, 1, 2, 8 };
+	struct scv_vector *v = scv_new(sizeof(struct rec), 0);
+	struct scv_vector *w = scv_new(sizeof(struct rec), 0);
+	size_t i;
+	size_t k;
+
+	ASSERT(v != NULL && w != NULL);
+
+	/* Any thread count sorts exactly like scv_sort(), also for the order
+	 * of equal keys, which an unstable sort does not otherwise fix */
+	for (k = 0; k < ARRAY_SIZE(nthreads); ++k) {
+		scv_clear(v);
+
+		for (i = 0; i < 100000; ++i) {
+			struct rec r;
+
+			r.key = next_rand() % 1000;
+			r.other[0] = (int) i;
+			r.other[1] = 0;
+
+			scv_push_back(v, &r);
+		}
+
+		ASSERT_EQ(scv_copy(w, v), SCV_OK);
+		ASSERT_EQ(scv_sort(w, compare_rec), SCV_OK);
+
+		ASSERT_EQ(scv_sort_parallel(v, compare_rec, nthreads[k]), SCV_OK);
+		ASSERT_MEM_EQ(scv_data(w), scv_data(v), scv_size(v) * sizeof(struct rec));
+	}
+
+	scv_delete(w);
+	scv_delete(v);
+
+	PASS();
+}
+#endif
+
+/* scv_radix_sort */
+
+TEST radix_sort_signed(void)
+{
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	struct scv_vector *w = scv_new(sizeof(int), 0);
+	size_t i;
+
+	ASSERT(v != NULL && w != NULL);
+
+	for (i = 0; i < 20000; ++i) {
+		int val = next_rand() - 0x400000;
+
+		if (i % 100 == 0) {
+			val = i % 200 == 0 ? -2147483647 - 1 : 2147483647;
+		}
+
+		scv_push_back(v, &val);
+	}
+
+	ASSERT_EQ(scv_copy(w, v), SCV_OK);
+
+	ASSERT_EQ(scv_radix_sort(v, 0, sizeof(int), SCV_RADIX_SIGNED), SCV_OK);
+	ASSERT_EQ(scv_sort(w, compare_int), SCV_OK);
+
+	ASSERT_MEM_EQ(scv_data(w), scv_data(v), scv_size(v) * sizeof(int));
+
+	scv_delete(w);
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST radix_sort_unsigned(void)
+{
+	struct scv_vector *v = scv_new(sizeof(unsigned long), 0);
+	size_t i;
+
+	ASSERT(v != NULL);
+
+	for (i = 0; i < 20000; ++i) {
+		unsigned long val = (unsigned long) next_rand() * 0x9E3779B1ul;
+
+		scv_push_back(v, &val);
+	}
+
+	ASSERT_EQ(scv_radix_sort(v, 0, sizeof(unsigned long), SCV_RADIX_UNSIGNED), SCV_OK);
+
+	for (i = 1; i < scv_size(v); ++i) {
+		ASSERT(*(unsigned long *) scv_at(v, i - 1) <= *(unsigned long *) scv_at(v, i));
+	}
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST radix_sort_key_offset(void)
+{
+	struct scv_vector *v = scv_new(sizeof(struct rec), 0);
+	size_t i;
+
+	ASSERT(v != NULL);
+
+	/* Key in other[1], with only one varying byte, and sequence in key */
+	for (i = 0; i < 5000; ++i) {
+		struct rec r;
+
+		r.key = (int) i;
+		r.other[0] = 0;
+		r.other[1] = next_rand() % 200;
+
+		scv_push_back(v, &r);
+	}
+
+	ASSERT_EQ(scv_radix_sort(v, offsetof(struct rec, other[1]), sizeof(int),
+	                         SCV_RADIX_SIGNED), SCV_OK);
+
+	/* Sort is stable, so elements with equal keys keep their order */
+	for (i = 1; i < scv_size(v); ++i) {
+		const struct rec *a = (const struct rec *) scv_at(v, i - 1);
+		const struct rec *b = (const struct rec *) scv_at(v, i);
+
+		ASSERT(a->other[1] < b->other[1]
+		    || (a->other[1] == b->other[1] && a->key < b->key));
+	}
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST radix_sort_invalid(void)
+{
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	struct scv_vector *w = scv_new(sizeof(char), 0);
+
+	ASSERT(v != NULL && w != NULL);
+
+	ASSERT_EQ(scv_radix_sort(v, 0, 0, 0), SCV_EINVAL);
+	ASSERT_EQ(scv_radix_sort(v, 1, sizeof(int), 0), SCV_EINVAL);
+	ASSERT_EQ(scv_radix_sort(v, sizeof(int) + 1, 1, 0), SCV_EINVAL);
+	ASSERT_EQ(scv_radix_sort_scratch(v, 0, sizeof(int), 0, w), SCV_EINVAL);
+	ASSERT_EQ(scv_radix_sort_scratch(v, 0, sizeof(int), 0, v), SCV_EINVAL);
+
+	scv_delete(w);
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_radix_sort_scratch */
+
+TEST radix_sort_scratch(void)
+{
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	struct scv_vector *scratch = scv_new(sizeof(int), 0);
+	size_t capacity = 0;
+	int round;
+
+	ASSERT(v != NULL && scratch != NULL);
+
+	for (round = 0; round < 3; ++round) {
+		fill_ints(v, 10000, 0);
+
+		ASSERT_EQ(scv_radix_sort_scratch(v, 0, sizeof(int), SCV_RADIX_SIGNED, scratch),
+		          SCV_OK);
+		ASSERT(is_sorted_int(v));
+
+		/* The scratch vector is only grown the first time */
+		if (round == 0) {
+			capacity = scv_capacity(scratch);
+		}
+
+		ASSERT_EQ(scv_capacity(scratch), capacity);
+	}
+
+	scv_delete(scratch);
+	scv_delete(v);
+
+	PASS();
+}
+
+/* scv_stable_sort */
+
+static int compare_rec_other(const void *lhs, const void *rhs)
+{
+	return compare_int(&((const struct rec *) lhs)->other[1],
+	                   &((const struct rec *) rhs)->other[1]);
+}
+
+/*
+ * Check `v` is ordered by other[1], and by key among equal other[1].
+ */
+static int is_stable_rec(struct scv_vector *v)
+{
+	size_t i;
+
+	for (i = 1; i < scv_size(v); ++i) {
+		const struct rec *a = (const struct rec *) scv_at(v, i - 1);
+		const struct rec *b = (const struct rec *) scv_at(v, i);
+
+		if (!(a->other[1] < b->other[1]
+		   || (a->other[1] == b->other[1] && a->key < b->key))) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+TEST stable_sort_patterns(void)
+{
+	static const size_t sizes[] = { 0, 1, 2, 10, 32, 33, 100, 1000, 50000 };
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	struct scv_vector *w = scv_new(sizeof(int), 0);
+	size_t k;
+	int pattern;
+
+	ASSERT(v != NULL && w != NULL);
+
+	for (pattern = 0; pattern < 7; ++pattern) {
+		for (k = 0; k < ARRAY_SIZE(sizes); ++k) {
+			fill_ints(v, sizes[k], pattern);
+
+			ASSERT_EQ(scv_copy(w, v), SCV_OK);
+
+			qsort(scv_data(w), scv_size(w), sizeof(int), compare_int);
+
+			ASSERT_EQ(scv_stable_sort(v, compare_int), SCV_OK);
+			ASSERT_MEM_EQ(scv_data(w), scv_data(v), scv_size(v) * sizeof(int));
+		}
+	}
+
+	scv_delete(w);
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST stable_sort_stability(void)
+{
+	struct scv_vector *v = scv_new(sizeof(struct rec), 0);
+	int pattern;
+
+	ASSERT(v != NULL);
+
+	for (pattern = 0; pattern < 4; ++pattern) {
+		size_t n = 20000;
+		size_t i;
+
+		scv_clear(v);
+
+		/* Sequence in key, sort key in other[1] */
+		for (i = 0; i < n; ++i) {
+			struct rec r;
+
+			r.key = (int) i;
+			r.other[0] = 0;
+
+			switch (pattern) {
+			case 0: r.other[1] = next_rand() % 100; break;
+			case 1: r.other[1] = (int) (n - i) / 3; break;
+			case 2: r.other[1] = (int) (i % 1000) / 2; break;
+			default: r.other[1] = (int) (i / 2) ^ (next_rand() % 64 == 0 ? 7 : 0); break;
+			}
+
+			scv_push_back(v, &r);
+		}
+
+		ASSERT_EQ(scv_stable_sort(v, compare_rec_other), SCV_OK);
+		ASSERT(is_stable_rec(v));
+	}
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST stable_sort_multi_key(void)
+{
+	struct scv_vector *v = scv_new(sizeof(struct rec), 0);
+	size_t i;
+
+	ASSERT(v != NULL);
+
+	for (i = 0; i < 5000; ++i) {
+		struct rec r;
+
+		r.key = next_rand() % 300;
+		r.other[0] = 0;
+		r.other[1] = next_rand() % 20;
+
+		scv_push_back(v, &r);
+	}
+
+	/* Sorting by key, then by other[1], orders by other[1], then key */
+	ASSERT_EQ(scv_stable_sort(v, compare_rec), SCV_OK);
+	ASSERT_EQ(scv_stable_sort(v, compare_rec_other), SCV_OK);
+
+	for (i = 1; i < scv_size(v); ++i) {
+		const struct rec *a = (const struct rec *) scv_at(v, i - 1);
+		const struct rec *b = (const struct rec *) scv_at(v, i);
+
+		ASSERT(a->other[1] < b->other[1]
+		    || (a->other[1] == b->other[1] && a->key <= b->key));
+	}
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST stable_sort_big(void)
+{
+	struct scv_vector *v = scv_new(sizeof(struct big), 0);
+	size_t i;
+
+	ASSERT(v != NULL);
+
+	for (i = 0; i < 500; ++i) {
+		struct big b;
+
+		memset(&b, 0, sizeof b);
+		b.key = next_rand() % 50;
+		b.payload[0] = (char) (i & 0x7F);
+		b.payload[1] = (char) (i >> 7);
+		b.payload[299] = (char) (b.key & 0x7F);
+
+		scv_push_back(v, &b);
+	}
+
+	ASSERT_EQ(scv_stable_sort(v, compare_int), SCV_OK);
+
+	for (i = 0; i < scv_size(v); ++i) {
+		const struct big *b = (const struct big *) scv_at(v, i);
+
+		ASSERT_EQ(b->payload[299], (char) (b->key & 0x7F));
+
+		if (i > 0) {
+			const struct big *a = (const struct big *) scv_at(v, i - 1);
+
+			ASSERT(a->key < b->key
+			    || (a->key == b->key
+			     && a->payload[1] * 128 + a->payload[0] < b->payload[1] * 128 + b->payload[0]));
+		}
+	}
+
+	scv_delete(v);
+
+	PASS();
+}
+
+TEST stable_sort_scratch(void)
+{
+	struct scv_vector *v = scv_new(sizeof(int), 0);
+	struct scv_vector *scratch = scv_new(sizeof(int), 0);
+	struct scv_vector *wrong = scv_new(sizeof(short), 0);
+	size_t capacity = 0;
+	int round;
+
+	ASSERT(v != NULL && scratch != NULL && wrong != NULL);
+
+	for (round = 0; round < 3; ++round) {
+		fill_ints(v, 10000, 0);
+
+		ASSERT_EQ(scv_stable_sort_scratch(v, compare_int, scratch), SCV_OK);
+		ASSERT(is_sorted_int(v));
+
+		/* The scratch vector is only grown the first time */
+		if (round == 0) {
+			capacity = scv_capacity(scratch);
+		}
+
+		ASSERT_EQ(scv_capacity(scratch), capacity);
+	}
+
+	ASSERT_EQ(scv_stable_sort_scratch(v, compare_int, wrong), SCV_EINVAL);
+	ASSERT_EQ(scv_stable_sort_scratch(v, compare_int, v), SCV_EINVAL);
+
+	scv_delete(wrong);
+	scv_delete(scratch);
+	scv_delete(v);
+
+	PASS();
+}
+
+SUITE(sort)
+{
+	RUN_TEST(sort_empty);
+	RUN_TEST(sort_patterns);
+	RUN_TEST(sort_objsize);
+
+	RUN_TEST(sort_ctx);
+
+	RUN_TEST(sort_parallel_small);
+	RUN_TEST(sort_parallel);
+	RUN_TEST(sort_parallel_objsize);
+#if defined(SCV_NO_THREADS)
+	RUN_TEST(sort_parallel_no_threads);
+#endif
+
+	RUN_TEST(radix_sort_signed);
+	RUN_TEST(radix_sort_unsigned);
+	RUN_TEST(radix_sort_key_offset);
+	RUN_TEST(radix_sort_invalid);
+
+	RUN_TEST(radix_sort_scratch);
+
+	RUN_TEST(stable_sort_patterns);
+	RUN_TEST(stable_sort_stability);
+	RUN_TEST(stable_sort_multi_key);
+	RUN_TEST(stable_sort_big);
+
+	RUN_TEST(stable_sort_scratch);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char *argv[])
+{
+	GREATEST_MAIN_BEGIN();
+	RUN_SUITE(sort);
+	GREATEST_MAIN_END();
+}